@@ -0,0 +1,506 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "batch_movegen.h"
+#include <bit>
+
+using namespace chess;
+
+namespace {
+
+    // One board per lane, GCC lowers the operators to AVX-512 / AVX2 instructions with -march=native
+    typedef uint64_t lanes __attribute__((vector_size(batch_movegen_lanes * sizeof(uint64_t))));
+
+    const uint64_t not_a_file = ~0x0101010101010101ULL,
+                   not_h_file = ~0x8080808080808080ULL,
+                   not_ab_files = ~0x0303030303030303ULL,
+                   not_gh_files = ~0xC0C0C0C0C0C0C0C0ULL,
+                   rank_3 = 0x0000000000FF0000ULL,
+                   rank_6 = 0x0000FF0000000000ULL;
+
+    enum direction { north, south, east, west, north_east, north_west, south_east, south_west };
+
+    /*
+     * Everything the serialisation step needs to know about a board's king safety.
+     * pin_rays[d] holds the squares between the king and a pinner in direction d (pinner included),
+     * or 0 if there is no pin in that direction.
+     */
+    struct king_safety
+    {
+        uint64_t attacked, checkers, check_evasions, pinned;
+        uint64_t pin_rays[8];
+    };
+
+    // Turns a per-lane comparison result into a mask of all ones or all zeros
+    inline lanes nonzero(lanes const& v)
+    {
+        return (lanes)(v != 0);
+    }
+
+    inline lanes select(lanes const& mask, lanes const& a, lanes const& b)
+    {
+        return (a & mask) | (b & ~mask);
+    }
+
+    template<direction D>
+    inline lanes shift(lanes const& b, int n = 1)
+    {
+        if constexpr (D == north)           return b << (8 * n);
+        else if constexpr (D == south)      return b >> (8 * n);
+        else if constexpr (D == east)       return b << n;
+        else if constexpr (D == west)       return b >> n;
+        else if constexpr (D == north_east) return b << (9 * n);
+        else if constexpr (D == north_west) return b << (7 * n);
+        else if constexpr (D == south_east) return b >> (7 * n);
+        else                                return b >> (9 * n);
+    }
+
+    // Squares a piece can't wrap onto when moving in direction D
+    template<direction D>
+    constexpr uint64_t wrap_mask()
+    {
+        if constexpr (D == east || D == north_east || D == south_east) return not_a_file;
+        else if constexpr (D == west || D == north_west || D == south_west) return not_h_file;
+        else return ~0ULL;
+    }
+
+    /*
+     * Kogge-Stone occluded fill, returns all squares attacked along direction D by the sliders in gen,
+     * the first blocker on every ray is included.
+     */
+    template<direction D>
+    inline lanes sliding_attacks(lanes gen, lanes empty)
+    {
+        empty &= wrap_mask<D>();
+
+        gen |= empty & shift<D>(gen, 1);
+        empty &= shift<D>(empty, 1);
+        gen |= empty & shift<D>(gen, 2);
+        empty &= shift<D>(empty, 2);
+        gen |= empty & shift<D>(gen, 4);
+
+        return shift<D>(gen) & wrap_mask<D>();
+    }
+
+    inline lanes knight_attacks_setwise(lanes const& b)
+    {
+        auto l1 = (b >> 1) & not_h_file;
+        auto l2 = (b >> 2) & not_gh_files;
+        auto r1 = (b << 1) & not_a_file;
+        auto r2 = (b << 2) & not_ab_files;
+
+        auto h1 = l1 | r1;
+        auto h2 = l2 | r2;
+
+        return (h1 << 16) | (h1 >> 16) | (h2 << 8) | (h2 >> 8);
+    }
+
+    inline lanes king_attacks_setwise(lanes const& b)
+    {
+        auto horizontal = ((b << 1) & not_a_file) | ((b >> 1) & not_h_file);
+        auto row = b | horizontal;
+
+        return horizontal | (row << 8) | (row >> 8);
+    }
+
+    inline lanes white_pawn_attacks_setwise(lanes const& b)
+    {
+        return ((b << 9) & not_a_file) | ((b << 7) & not_h_file);
+    }
+
+    inline lanes black_pawn_attacks_setwise(lanes const& b)
+    {
+        return ((b >> 7) & not_a_file) | ((b >> 9) & not_h_file);
+    }
+
+
+    /*
+     * Checks and pins along a single direction from the king.
+     * The ray from the king is filled once through empty squares and once more through empty squares
+     * and the first friendly piece, if the second ray ends on a slider of the right type, that friendly piece is pinned.
+     */
+    template<direction D>
+    inline void king_ray(lanes const& king, lanes const& empty, lanes const& own, lanes const& enemy_sliders,
+                         lanes& checkers, lanes& check_block, lanes& pinned, lanes& pin_ray)
+    {
+        auto ray = sliding_attacks<D>(king, empty);
+
+        auto checker = ray & enemy_sliders;
+        checkers |= checker;
+        check_block |= ray & nonzero(checker);
+
+        auto own_blocker = ray & own;
+        auto xray = sliding_attacks<D>(king, empty | own_blocker);
+
+        auto is_pinned = nonzero((xray ^ ray) & enemy_sliders);
+
+        pinned |= own_blocker & is_pinned;
+        pin_ray = xray & is_pinned;
+    }
+
+
+    void compute_king_safety(const board* const* boards, size_t count, king_safety* out)
+    {
+        // Unused lanes stay empty, whatever gets computed for them is discarded
+        lanes own{}, enemy{}, kings{}, pawns{}, knights{}, rooks_queens{}, bishops_queens{}, black_to_move{};
+
+        for (size_t lane = 0; lane < count; lane++)
+        {
+            auto& b = *boards[lane];
+            auto pieces = b.disentangle_pieces();
+
+            own[lane] = b.current_player_pieces;
+            enemy[lane] = b.get_enemy_pieces();
+            kings[lane] = pieces.kings;
+            pawns[lane] = pieces.pawns;
+            knights[lane] = pieces.knights;
+            rooks_queens[lane] = pieces.rooks | pieces.queens;
+            bishops_queens[lane] = pieces.bishops | pieces.queens;
+            black_to_move[lane] = b.flipped ? ~0ULL : 0;
+        }
+
+        auto occupied = own | enemy;
+        auto empty = ~occupied;
+        auto king = own & kings;
+
+        auto enemy_rq = enemy & rooks_queens;
+        auto enemy_bq = enemy & bishops_queens;
+
+        //region Squares attacked by the enemy
+
+        // Sliders see through the king, otherwise the king could step back along the checking ray
+        auto xray_empty = empty | king;
+
+        auto enemy_pawns = enemy & pawns;
+
+        lanes attacked = knight_attacks_setwise(enemy & knights) |
+                         king_attacks_setwise(enemy & kings) |
+                         select(black_to_move,
+                                white_pawn_attacks_setwise(enemy_pawns),
+                                black_pawn_attacks_setwise(enemy_pawns));
+
+        attacked |= sliding_attacks<north>(enemy_rq, xray_empty) | sliding_attacks<south>(enemy_rq, xray_empty) |
+                    sliding_attacks<east>(enemy_rq, xray_empty)  | sliding_attacks<west>(enemy_rq, xray_empty);
+
+        attacked |= sliding_attacks<north_east>(enemy_bq, xray_empty) |
+                    sliding_attacks<north_west>(enemy_bq, xray_empty) |
+                    sliding_attacks<south_east>(enemy_bq, xray_empty) |
+                    sliding_attacks<south_west>(enemy_bq, xray_empty);
+        //endregion
+
+        //region Checks and pins
+
+        lanes checkers = (knight_attacks_setwise(king) & enemy & knights) |
+                         (select(black_to_move,
+                                 black_pawn_attacks_setwise(king),
+                                 white_pawn_attacks_setwise(king)) & enemy_pawns);
+
+        lanes check_block{}, pinned{}, pin_rays[8];
+
+        king_ray<north>(king, empty, own, enemy_rq, checkers, check_block, pinned, pin_rays[north]);
+        king_ray<south>(king, empty, own, enemy_rq, checkers, check_block, pinned, pin_rays[south]);
+        king_ray<east>(king, empty, own, enemy_rq, checkers, check_block, pinned, pin_rays[east]);
+        king_ray<west>(king, empty, own, enemy_rq, checkers, check_block, pinned, pin_rays[west]);
+
+        king_ray<north_east>(king, empty, own, enemy_bq, checkers, check_block, pinned, pin_rays[north_east]);
+        king_ray<north_west>(king, empty, own, enemy_bq, checkers, check_block, pinned, pin_rays[north_west]);
+        king_ray<south_east>(king, empty, own, enemy_bq, checkers, check_block, pinned, pin_rays[south_east]);
+        king_ray<south_west>(king, empty, own, enemy_bq, checkers, check_block, pinned, pin_rays[south_west]);
+        //endregion
+
+        for (size_t lane = 0; lane < count; lane++)
+        {
+            auto& ks = out[lane];
+            ks.attacked = attacked[lane];
+            ks.checkers = checkers[lane];
+            ks.pinned = pinned[lane];
+
+            // No check - anything goes, single check - capture or block, double check - only the king can move
+            switch (std::popcount(ks.checkers))
+            {
+                case 0: ks.check_evasions = ~0ULL; break;
+                case 1: ks.check_evasions = ks.checkers | check_block[lane]; break;
+                default: ks.check_evasions = 0; break;
+            }
+
+            for (int d = 0; d < 8; d++)
+                ks.pin_rays[d] = pin_rays[d][lane];
+        }
+    }
+
+
+    inline uint64_t pin_mask(king_safety const& ks, uint64_t const& bit)
+    {
+        if (!(ks.pinned & bit)) [[likely]]
+            return ~0ULL;
+
+        for (auto& ray : ks.pin_rays)
+            if (ray & bit)
+                return ray;
+
+        return ~0ULL;
+    }
+
+
+    template<int Color>
+    game_state serialise_moves(board const& b, king_safety const& ks, movegen_result& result)
+    {
+        result.moves_count = 0;
+
+        auto add_moves = [&](uint8_t src, uint64_t targets)
+        {
+            while (targets)
+            {
+                uint8_t dst = __builtin_ctzll(poplsb(targets));
+                result.moves[result.moves_count++] = move(src, dst);
+            }
+        };
+
+        auto add_pawn_moves = [&](uint64_t targets, int src_offset)
+        {
+            while (targets)
+            {
+                auto bit = poplsb(targets);
+                uint8_t dst = __builtin_ctzll(bit);
+                uint8_t src = dst + src_offset;
+
+                if (bit & pawn_promotion_squares) [[unlikely]]
+                {
+                    result.moves[result.moves_count++] = move(src, dst, QUEENS);
+                    result.moves[result.moves_count++] = move(src, dst, ROOKS);
+                    result.moves[result.moves_count++] = move(src, dst, BISHOPS);
+                    result.moves[result.moves_count++] = move(src, dst, KNIGHTS);
+                }
+                else result.moves[result.moves_count++] = move(src, dst);
+            }
+        };
+
+        auto pieces = b.disentangle_pieces();
+        auto own = b.current_player_pieces;
+        auto enemy = b.get_enemy_pieces();
+        auto occupied = own | enemy;
+        auto empty = ~occupied;
+
+        auto king = own & pieces.kings;
+        uint8_t king_pos = __builtin_ctzll(king);
+
+        add_moves(king_pos, king_moves[king_pos] & ~own & ~ks.attacked);
+
+        if (ks.check_evasions)
+        {
+            auto targets = ~own & ks.check_evasions;
+
+            //region Pawns
+            auto our_pawns = own & pieces.pawns;
+            auto free_pawns = our_pawns & ~ks.pinned;
+
+            uint64_t pushes, double_pushes, west_captures, east_captures;
+
+            if constexpr (Color == C_WHITE)
+            {
+                pushes = (free_pawns << 8) & empty;
+                double_pushes = ((pushes & rank_3) << 8) & empty & ks.check_evasions;
+                west_captures = ((free_pawns << 7) & not_h_file) & enemy & ks.check_evasions;
+                east_captures = ((free_pawns << 9) & not_a_file) & enemy & ks.check_evasions;
+                pushes &= ks.check_evasions;
+
+                add_pawn_moves(west_captures, -7);
+                add_pawn_moves(east_captures, -9);
+                add_pawn_moves(pushes, -8);
+                add_pawn_moves(double_pushes, -16);
+            }
+            else
+            {
+                pushes = (free_pawns >> 8) & empty;
+                double_pushes = ((pushes & rank_6) >> 8) & empty & ks.check_evasions;
+                west_captures = ((free_pawns >> 9) & not_h_file) & enemy & ks.check_evasions;
+                east_captures = ((free_pawns >> 7) & not_a_file) & enemy & ks.check_evasions;
+                pushes &= ks.check_evasions;
+
+                add_pawn_moves(west_captures, 9);
+                add_pawn_moves(east_captures, 7);
+                add_pawn_moves(pushes, 8);
+                add_pawn_moves(double_pushes, 16);
+            }
+
+            // Pinned pawns can still move along the pin ray
+            auto pinned_pawns = our_pawns & ks.pinned;
+            while (pinned_pawns)
+            {
+                auto bit = poplsb(pinned_pawns);
+                uint8_t src = __builtin_ctzll(bit);
+                auto allowed = pin_mask(ks, bit) & ks.check_evasions;
+
+                uint64_t single = (Color == C_WHITE ? bit << 8 : bit >> 8) & empty;
+                uint64_t dbl = (Color == C_WHITE ? (single & rank_3) << 8 : (single & rank_6) >> 8) & empty;
+                uint64_t captures = pawn_attacks[Color][src] & enemy;
+
+                auto moves = (single | dbl | captures) & allowed;
+
+                while (moves)
+                {
+                    auto dst_bit = poplsb(moves);
+                    uint8_t dst = __builtin_ctzll(dst_bit);
+
+                    if (dst_bit & pawn_promotion_squares) [[unlikely]]
+                    {
+                        result.moves[result.moves_count++] = move(src, dst, QUEENS);
+                        result.moves[result.moves_count++] = move(src, dst, ROOKS);
+                        result.moves[result.moves_count++] = move(src, dst, BISHOPS);
+                        result.moves[result.moves_count++] = move(src, dst, KNIGHTS);
+                    }
+                    else result.moves[result.moves_count++] = move(src, dst);
+                }
+            }
+            //endregion
+
+            //region Pieces
+            auto rooks_queens = own & (pieces.rooks | pieces.queens);
+            while (rooks_queens)
+            {
+                auto bit = poplsb(rooks_queens);
+                uint8_t src = __builtin_ctzll(bit);
+                add_moves(src, get_rook_attacks(occupied, src) & targets & pin_mask(ks, bit));
+            }
+
+            auto bishops_queens = own & (pieces.bishops | pieces.queens);
+            while (bishops_queens)
+            {
+                auto bit = poplsb(bishops_queens);
+                uint8_t src = __builtin_ctzll(bit);
+                add_moves(src, get_bishop_attacks(occupied, src) & targets & pin_mask(ks, bit));
+            }
+
+            // A pinned knight can never move
+            auto knights = own & pieces.knights & ~ks.pinned;
+            while (knights)
+            {
+                uint8_t src = __builtin_ctzll(poplsb(knights));
+                add_moves(src, knight_attacks[src] & targets);
+            }
+            //endregion
+
+            //region Castling
+            if (!ks.checkers)
+            {
+                if constexpr (Color == C_WHITE)
+                {
+                    if (b.castling_rights & WHITE_KING_SIDE &&
+                        !((white_king_side_castles_mask & occupied) | (white_king_side_castles_mask & ks.attacked)))
+                        result.moves[result.moves_count++] = move(king_pos, (uint8_t) square_index::g1);
+
+                    if (b.castling_rights & WHITE_QUEEN_SIDE &&
+                        !(((white_queen_side_castles_mask | b1) & occupied) | (white_queen_side_castles_mask & ks.attacked)))
+                        result.moves[result.moves_count++] = move(king_pos, (uint8_t) square_index::c1);
+                }
+                else
+                {
+                    if (b.castling_rights & BLACK_KING_SIDE &&
+                        !((black_king_side_castles_mask & occupied) | (black_king_side_castles_mask & ks.attacked)))
+                        result.moves[result.moves_count++] = move(king_pos, (uint8_t) square_index::g8);
+
+                    if (b.castling_rights & BLACK_QUEEN_SIDE &&
+                        !(((black_queen_side_castles_mask | b8) & occupied) | (black_queen_side_castles_mask & ks.attacked)))
+                        result.moves[result.moves_count++] = move(king_pos, (uint8_t) square_index::c8);
+                }
+            }
+            //endregion
+
+            //region En passant
+            /*
+             * Rare enough to just verify directly, the captured pawn and the capturing pawn both
+             * leave their squares, which can expose the king along a rank as well as along a pin ray.
+             */
+            if (b.en_passant_possible) [[unlikely]]
+            {
+                const int ep_y = 4 - (Color == C_BLACK);
+                auto captured = get_bit(b.en_passant_x, ep_y);
+                auto target = get_bit(b.en_passant_x, Color == C_BLACK ? 2 : 5);
+
+                auto enemy_rq = enemy & (pieces.rooks | pieces.queens);
+                auto enemy_bq = enemy & (pieces.bishops | pieces.queens);
+
+                // Knight checks or pawn checks by another pawn can't be resolved by en passant
+                bool unresolvable_check = ks.checkers & ~captured & (pieces.knights | pieces.pawns);
+
+                for (int dx = -1; dx <= 1 && !unresolvable_check; dx += 2)
+                {
+                    int x = b.en_passant_x + dx;
+                    if (x < 0 || x > 7) continue;
+
+                    auto src_bit = get_bit(x, ep_y);
+                    if (!(src_bit & own & pieces.pawns)) continue;
+
+                    auto occupied_after = (occupied ^ src_bit ^ captured) | target;
+
+                    if ((get_rook_attacks(occupied_after, king_pos) & enemy_rq & ~captured) ||
+                        (get_bishop_attacks(occupied_after, king_pos) & enemy_bq & ~captured))
+                        continue;
+
+                    result.moves[result.moves_count++] = move(get_index(x, ep_y), __builtin_ctzll(target));
+                }
+            }
+            //endregion
+        }
+
+        if (result.moves_count)
+            return game_state::playing;
+
+        return ks.checkers ? game_state::checkmate : game_state::draw;
+    }
+}
+
+
+void chess::generate_moves_batch(const board* const* boards,
+                                 movegen_result* results,
+                                 game_state* states,
+                                 size_t count)
+{
+    king_safety safety[batch_movegen_lanes];
+
+    for (size_t first = 0; first < count; first += batch_movegen_lanes)
+    {
+        auto n = std::min(batch_movegen_lanes, count - first);
+
+        compute_king_safety(boards + first, n, safety);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            auto& b = *boards[first + i];
+            auto& result = results[first + i];
+
+            // Same insufficient material rule as board::generate_moves
+            auto knights = b.rooks_queens_knights & b.pawns_knights_kings;
+            auto kings = b.bishops_queens_kings & b.pawns_knights_kings;
+            auto pawns = set_difference(b.pawns_knights_kings, knights | kings);
+            auto rooks_or_queens = set_difference(b.rooks_queens_knights, knights);
+            auto bishops_or_queens = set_difference(b.bishops_queens_kings, kings);
+
+            if (!pawns && !rooks_or_queens && (std::popcount(bishops_or_queens) + std::popcount(knights)) < 2)
+            {
+                result.moves_count = 0;
+                states[first + i] = game_state::insufficient_material;
+                continue;
+            }
+
+            states[first + i] = b.flipped ?
+                    serialise_moves<C_BLACK>(b, safety[i], result) :
+                    serialise_moves<C_WHITE>(b, safety[i], result);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_BATCH_MOVEGEN_H
+#define FIREFLY_BATCH_MOVEGEN_H
+
+#include "board.h"
+
+namespace chess {
+
+    /*
+     * Number of boards processed by a single SIMD step, one 64-bit lane per board.
+     * 8 lanes fill a zmm register with AVX-512, 4 lanes fill a ymm register with AVX2.
+     */
+#ifdef __AVX512F__
+    constexpr size_t batch_movegen_lanes = 8;
+#else
+    constexpr size_t batch_movegen_lanes = 4;
+#endif
+
+    /*
+     * Generates moves for count boards at once, the result is identical to calling
+     * boards[i]->generate_moves(results[i]) for every board.
+     *
+     * 1. Attacked squares, checkers, check evasion masks and pin rays are computed for
+     * batch_movegen_lanes boards at a time with set-wise (Kogge-Stone) fills,
+     * so nothing in this step loops over individual pieces or squares.
+     *
+     * 2. The legal move bitboards are then serialised into each board's movegen_result.
+     *
+     * Separate code path from board::generate_moves, see batch_movegen_perft in testing/board_test.cpp
+     */
+    void generate_moves_batch(const board* const* boards,
+                              movegen_result* results,
+                              game_state* states,
+                              size_t count);
+}
+
+#endif //FIREFLY_BATCH_MOVEGEN_H
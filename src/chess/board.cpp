@@ -23,9 +23,7 @@
 #include <string>
 #include <utils/utils.h>
 #include <immintrin.h>
-//#include <engine/neural/utils/compressed_policy_map.h>
-//#include <engine/neural/utils/uncompressed_policy_map.h>
-#include <engine/neural/utils/uncompressed_policy_map.h>
+#include <engine/neural/utils/compact_policy_map.h>
 using namespace chess;
 using namespace std;
 
@@ -109,40 +107,17 @@ bool chess::move::operator==(const move &other) const {
 
 uint16_t chess::move::to_policy_index() const
 {
-
-    //Key: 3838590963604091776
-    //Shift: 51  max idx = 8190
-    //return policy_map[((src | (dst << 6) | (promotion << 12)) * 0x35456A24C7A57380) >> 51];
-
-    uint16_t final_index;
-    if (promotion)
+    switch (promotion)
     {
-        //cout << (dst & 56) << endl;
-        if ((dst & 56) == 0)
-        {
-            //cout << "Hi" << endl;
-            // flip high 3 bits in src and dst
-            auto flipped_src_y = 56 - (src & 56);
-            auto flipped_dst_y = 56 - (dst & 56);
-
-
-
-            final_index = ((src & 7) | flipped_src_y );
-            final_index |= ((dst & 7) | flipped_dst_y) << 6;
-            final_index |= (KNIGHTS == promotion) ? 0 : promotion << 12;
-
-        }
-        else
-        {
-            final_index = (src | (dst << 6)) | (KNIGHTS == promotion ? 0 : promotion << 12);
-        }
+        case QUEENS:
+            return compact_promotion_policy_map[src & 7][(dst & 7) - (src & 7) + 1][0];
+        case ROOKS:
+            return compact_promotion_policy_map[src & 7][(dst & 7) - (src & 7) + 1][1];
+        case BISHOPS:
+            return compact_promotion_policy_map[src & 7][(dst & 7) - (src & 7) + 1][2];
+        default: [[likely]] // Knight promotions share the plain move's index
+            return compact_policy_map[src][dst];
     }
-    else final_index = src | (dst << 6);
-
-    final_index = (src | (dst << 6)) | (KNIGHTS == promotion ? 0 : promotion << 12);
-
-    return uncompressed_policy_map[final_index];
-    //return inverted_policy_map[to_uci_move()];
 }
 
 
@@ -158,16 +133,8 @@ void chess::move::flip()
 
 uint16_t chess::move::to_flipped_policy_index() const
 {
-    auto flipped_src_y = 56 - (src & 56);
-    auto flipped_dst_y = 56 - (dst & 56);
-
-
-
-    auto final_index = ((src & 7) | flipped_src_y );
-    final_index |= ((dst & 7) | flipped_dst_y) << 6;
-    final_index |= (KNIGHTS == promotion) ? 0 : promotion << 12;
-
-    return uncompressed_policy_map[final_index];
+    // Flipping the rank of a square is equivalent to 56 - (square & 56) | (square & 7)
+    return move(src ^ 56, dst ^ 56, promotion).to_policy_index();
 }
 
 board::board()
@@ -300,39 +267,6 @@ game_state board::generate_moves(movegen_result& result) const
     const uint64_t clip_right_side = ~0x101010101010101,
             clip_left_side = ~0x8080808080808080;
 
-    auto calculate_pins_and_king_attacks_rooks_vert = [&](int&& z)
-    {
-        auto ray = rook_pin_rays[i][z];
-        if (ray & king_square) {
-            ray &= rook_pin_ray_mask[z];
-            auto pieces_in_ray = ray & piece_union;
-
-            auto count = popcount(pieces_in_ray);
-
-            switch (count) {
-                case 2: // Piece is pinned
-                {
-                    pieces_in_ray ^= king_square;
-                    if (current_player_pieces & pieces_in_ray) {
-                        pinned_pieces |= pieces_in_ray;
-                        pinned_pieces_move_mask[__builtin_ctzll(pieces_in_ray)] = (ray | bit);
-                    }
-                    break;
-                }
-                case 1: // King is attacked
-                {
-                    king_attacker = bit;
-                    pieces_attacking_king++;
-                    king_attacker_attack_mask = ray;
-                    attacker_is_slider = true;
-                    break;
-                }
-            }
-            return true;
-        }
-        return false;
-    };
-
     auto calculate_pins_and_king_attacks_bishops = [&]()
     {
         for (int z = 0; z < 4; z++)
@@ -426,24 +360,25 @@ game_state board::generate_moves(movegen_result& result) const
                             If there are two pawns horizontally interposed between a rook (or queen)
                             and the king, en passant is impossible, because it would expose the king.
 
-                            en_passant_possible will only be set to true if there's a pawn that can
-                            be taken en passant AND an enemy pawn that can take that pawn en passant.
-
-                            Therefore, if there are three pieces in a rook's attack ray and one of
-                            them is a king and en passant is possible and the rook is on the rank
-                            where en passant would normally happen (rank 4 for white, rank 3 for black) then the two
-                            remaining pieces in the rook's attack mask are necessarily the two pawns
-                            that may participate in an en passant capture, in this specific case,
-                            set en_passant_possible to false.
-
-                            Once we get to this point, we already know that there are 3 pieces in a
-                            rook's attack mask and that one of them is a king, so we just need to
-                            check if the rook is on the proper rank and set en_passant_possible
-                            to false if it is.
+                            That's the case if the rook and the king are both on the rank where en passant
+                            happens (rank 4 for white, rank 3 for black) and the two remaining pieces in the
+                            ray are the pawn that can be taken en passant and one of ours right next to it.
+                            The rays of every direction end up here, so the ranks have to be checked,
+                            a rook on the en passant rank that x-rays the king along a file pins nothing.
 
                             If en_passant_possible was already false, nothing changes.
                          */
-                        en_passant_possible &= bool((i >> 3) != (4 - (Color == C_BLACK)));
+                        const int ep_y = 4 - (Color == C_BLACK);
+
+                        if ((i >> 3) == ep_y && (king_pos >> 3) == ep_y)
+                        {
+                            auto others = pieces_in_ray ^ king_square;
+                            auto captured = get_bit(en_passant_x, ep_y);
+
+                            if ((others & captured) &&
+                                ((others ^ captured) & current_player_pieces & pawns & ((captured << 1) | (captured >> 1))))
+                                en_passant_possible = false;
+                        }
                         break;
                     }
                 }
@@ -950,7 +885,7 @@ string board::print() const
 string board::to_fen() const {
     string fen;
 
-    uint64_t black_pieces, white_pieces;
+    uint64_t white_pieces;
 
     if (flipped)
     {
@@ -1094,7 +1029,7 @@ bool board::from_fen(string const& fen)
 
     int fen_idx = 0, board_x = 0, board_y = 7;
 
-    for (; fen_idx < piece_positions.size(); fen_idx++)
+    for (; fen_idx < int(piece_positions.size()); fen_idx++)
     {
         if (piece_positions[fen_idx] >= '0' && piece_positions[fen_idx] <= '9')
         {
@@ -1753,6 +1688,12 @@ uint64_t chess::board::hash() const
     return XXH64(this, sizeof(chess::board), 3498508396312845423);
 }
 
+uint64_t chess::board::position_key() const
+{
+    uint64_t state = flipped | (en_passant_possible << 1) | (en_passant_x << 2) | (castling_rights << 5);
+    return XXH64(this, sizeof(uint64_t) * 4, 3498508396312845423 ^ state);
+}
+
 
 string chess::board::move_to_algebraic_notation(chess::move const& move)
 {
@@ -77,10 +77,10 @@ extern const int tb_maxcount ;
 
     // Should be 15 bits
     struct move {
-        uint8_t
+        uint16_t
         src:6,
         dst:6,
-        promotion:4; // 1 unused bit
+        promotion:4;
 
         move(uint8_t src, uint8_t dst,uint8_t promotion=PAWNS);
         move(std::string const& uci_move);
@@ -346,6 +346,9 @@ extern const int tb_maxcount ;
         //endregion
 
         uint64_t hash() const;
+
+        // Hash of everything tfr_compare looks at, two boards with equal keys are (almost certainly) a repetition
+        uint64_t position_key() const;
         std::map<string, uint64_t> perft(int depth);
 
         string move_to_algebraic_notation(chess::move const&);
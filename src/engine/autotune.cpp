@@ -0,0 +1,289 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "autotune.h"
+
+#include <engine/mcts/search.h>
+#include <external/xxHash/xxh3.h>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+    // The same workload for every configuration: the opening, a busy middlegame and an endgame
+    const char* positions[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/5pk1/6p1/3R4/7P/6P1/r4PK1/8 w - - 0 40"
+    };
+
+    struct configuration
+    {
+        vector<string> options;
+        float nps = 0;
+        uint32_t p50 = 0, p99 = 0;
+    };
+
+    string cpu_model()
+    {
+        ifstream cpuinfo("/proc/cpuinfo");
+        string line;
+
+        while (getline(cpuinfo, line))
+        {
+            if (line.rfind("model name", 0) == 0 && line.find(':') != string::npos)
+            {
+                auto model = line.substr(line.find(':') + 1);
+                model.erase(0, model.find_first_not_of(' '));
+                return model;
+            }
+        }
+
+        return "unknown CPU";
+    }
+
+    // Chained over 1 MiB chunks, the weights file can be large
+    string file_hash(string const& file)
+    {
+        ifstream in(file, ios::binary);
+        vector<char> chunk(1 << 20);
+        uint64_t hash = 0;
+
+        while (in)
+        {
+            in.read(chunk.data(), chunk.size());
+            hash = XXH64(chunk.data(), in.gcount(), hash);
+        }
+
+        stringstream ss;
+        ss << hex << setw(16) << setfill('0') << hash;
+        return ss.str();
+    }
+
+    configuration measure(cxxopts::Options& options, vector<string> args, vector<string> const& config_options,
+                          chrono::milliseconds duration)
+    {
+        configuration result{config_options};
+
+        // The profile is for the fixed settings, later entries win
+        args.insert(args.end(), config_options.begin(), config_options.end());
+        args.emplace_back("--adaptive_batch=false");
+        args.emplace_back("--move_overhead=0");
+
+        auto parsed = autotune::parse(options, args);
+        mcts::search search(parsed);
+
+        search.net_manager.collect_latency_samples(true);
+
+        uint64_t nodes = 0;
+        chrono::duration<float> elapsed{0};
+
+        for (auto fen : positions)
+        {
+            search.initialize(fen);
+
+            mcts::search_limits limits;
+            limits.movetime = duration;
+
+            auto start = chrono::steady_clock::now();
+            search.expand_tree(limits);
+            elapsed += chrono::steady_clock::now() - start;
+
+            nodes += search.net_manager.nodes_processed;
+        }
+
+        auto samples = search.net_manager.take_latency_samples();
+        search.net_manager.collect_latency_samples(false);
+
+        result.nps = nodes / std::max(elapsed.count(), 1e-3f);
+
+        if (!samples.empty())
+        {
+            sort(samples.begin(), samples.end());
+            result.p50 = samples[samples.size() / 2];
+            result.p99 = samples[samples.size() * 99 / 100];
+        }
+
+        return result;
+    }
+}
+
+
+string autotune::profile_key(string const& weights_file, string const& device)
+{
+    return cpu_model() + "\t" + file_hash(weights_file) + "\t" + device;
+}
+
+
+vector<string> autotune::load_profile(string const& file, string const& key)
+{
+    ifstream in(file);
+    string line;
+
+    while (getline(in, line))
+    {
+        if (line.rfind(key + "\t", 0) != 0)
+            continue;
+
+        vector<string> profile_options;
+        stringstream ss(line.substr(key.size() + 1));
+        string option;
+
+        while (ss >> option)
+            profile_options.push_back(option);
+
+        cout << "info [autotune] Using the profile in " << file << ":" << line.substr(key.size()) << endl;
+        return profile_options;
+    }
+
+    return {};
+}
+
+
+void autotune::save_profile(string const& file, string const& key, vector<string> const& profile_options)
+{
+    vector<string> lines;
+
+    {
+        ifstream in(file);
+        string line;
+
+        while (getline(in, line))
+            if (line.rfind(key + "\t", 0) != 0)
+                lines.push_back(line);
+    }
+
+    if (lines.empty())
+        lines.emplace_back("# Firefly autotune profiles: CPU model, network hash, device, options");
+
+    stringstream ss;
+    ss << key << "\t";
+    for (size_t i = 0; i < profile_options.size(); i++)
+        ss << (i ? " " : "") << profile_options[i];
+
+    lines.push_back(ss.str());
+
+    ofstream out(file, ios::trunc);
+    for (auto& line : lines)
+        out << line << "\n";
+
+    if (out)
+        cout << "info [autotune] Saved the profile to " << file << endl;
+    else
+        cout << "info [autotune] Could not write " << file << endl;
+}
+
+
+vector<string> autotune::apply_profile(cxxopts::ParseResult const& command_line, vector<string> args,
+                                       vector<string> const& profile_options)
+{
+    for (auto& option : profile_options)
+    {
+        // --name=value
+        if (option.rfind("--", 0) != 0)
+            continue;
+
+        if (command_line.count(option.substr(2, option.find('=') - 2)) == 0)
+            args.push_back(option);
+    }
+
+    return args;
+}
+
+
+cxxopts::ParseResult autotune::parse(cxxopts::Options& options, vector<string> const& args)
+{
+    // parse takes argc and argv by reference in some versions of cxxopts
+    vector<char*> pointers;
+    for (auto& arg : args)
+        pointers.push_back(const_cast<char*>(arg.c_str()));
+    pointers.push_back(nullptr);
+
+    int argc = int(args.size());
+    char** argv = pointers.data();
+
+    return options.parse(argc, argv);
+}
+
+
+vector<string> autotune::run(cxxopts::Options& options, vector<string> const& args, chrono::milliseconds duration)
+{
+    auto command_line = parse(options, args);
+    bool cpu = command_line["d"].as<string>() == "cpu";
+
+    auto hardware_threads = std::max(2u, std::thread::hardware_concurrency());
+
+    vector<int> thread_counts;
+    for (int i = 1; i <= int(hardware_threads / 2); i *= 2)
+        thread_counts.push_back(i);
+
+    vector<int> batch_sizes = {64, 256, 1024};
+
+    // Backend instances only exist for the CPU, with the inference threads split between them
+    vector<int> backend_counts = {1};
+    if (cpu)
+        backend_counts.push_back(2);
+
+    vector<configuration> results;
+
+    for (auto threads : thread_counts)
+    {
+        for (auto batch_size : batch_sizes)
+        {
+            for (auto backends : backend_counts)
+            {
+                vector<string> config_options = {
+                    "--threads=" + to_string(threads),
+                    "--max_batch_size=" + to_string(batch_size)
+                };
+
+                if (cpu)
+                {
+                    config_options.push_back("--cpu_backends=" + to_string(backends));
+                    config_options.push_back("--cpu_inference_threads=" + to_string(std::max(1u, hardware_threads / 2 / backends)));
+                }
+
+                auto result = measure(options, args, config_options, duration);
+
+                cout << "info [autotune]";
+                for (auto& i : result.options)
+                    cout << " " << i;
+                cout << ": " << int(result.nps) << " nps, node latency p50 " << result.p50 << "us, p99 " << result.p99 << "us" << endl;
+
+                results.push_back(std::move(result));
+            }
+        }
+    }
+
+    auto best = max_element(results.begin(), results.end(), [](auto& a, auto& b) {
+        return a.nps < b.nps;
+    });
+
+    cout << "info [autotune] Best:";
+    for (auto& i : best->options)
+        cout << " " << i;
+    cout << ", " << int(best->nps) << " nps" << endl;
+
+    return best->options;
+}
@@ -0,0 +1,57 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_AUTOTUNE_H
+#define FIREFLY_AUTOTUNE_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cxxopts.hpp>
+
+/*
+ * Finds the fastest tree traversal threads, max batch size and CPU backends for a machine and remembers them.
+ *
+ * Profiles are lines of a text file: the CPU model, a hash of the network's weights and the device, separated by tabs,
+ * followed by the command line options that were the fastest for that combination.
+ * Options given on the command line take precedence over the profile's.
+ */
+namespace autotune
+{
+    std::string profile_key(std::string const& weights_file, std::string const& device);
+
+    // Options of the profile for key, empty if there's none
+    std::vector<std::string> load_profile(std::string const& file, std::string const& key);
+    void save_profile(std::string const& file, std::string const& key, std::vector<std::string> const& profile_options);
+
+    // args with every option of the profile added that command_line doesn't set
+    std::vector<std::string> apply_profile(cxxopts::ParseResult const& command_line, std::vector<std::string> args,
+                                           std::vector<std::string> const& profile_options);
+
+    // args[0] is the program name, as in argv
+    cxxopts::ParseResult parse(cxxopts::Options& options, std::vector<std::string> const& args);
+
+    /*
+     * Searches the same few positions for duration each with every combination on the grid,
+     * prints the nodes per second and the node latency percentiles of each and returns the options of the fastest.
+     */
+    std::vector<std::string> run(cxxopts::Options& options, std::vector<std::string> const& args,
+                                 std::chrono::milliseconds duration);
+}
+
+#endif //FIREFLY_AUTOTUNE_H
@@ -43,12 +43,24 @@ engine_interface::engine_interface(cxxopts::ParseResult& options) : search(optio
     //search.net_manager = new network_manager<lc0::LC0Network>(1,1024);
     //search.net_manager->autodetect_backends(neural_net_path);
 
-    search.initialize("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    game_fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    search.initialize(game_fen);
     debug = false;
     senjo::EngineOption limit_strength;
     limit_strength.setName("UCI_LimitStrength");
     limit_strength.setValue(0);
     engine_options.push_back(limit_strength);
+
+    // Search tree memory in MiB, 0 for no limit
+    engine_options.emplace_back("NodeMemory", std::to_string(options["node_memory"].as<int>()),
+                                senjo::EngineOption::Spin, 0, 1024 * 1024);
+
+    // Time in ms kept back from every move for the GUI
+    engine_options.emplace_back("MoveOverhead", std::to_string(options["move_overhead"].as<int>()),
+                                senjo::EngineOption::Spin, 0, 5000);
+
+    // Tells the GUI that the engine can ponder, go ponder works either way
+    engine_options.emplace_back("Ponder", "false", senjo::EngineOption::Checkbox);
 }
 
 std::list<senjo::EngineOption> engine_interface::getOptions() const {
@@ -58,6 +70,20 @@ std::list<senjo::EngineOption> engine_interface::getOptions() const {
 bool engine_interface::setEngineOption(const std::string &optionName, const std::string &optionValue) {
 
     senjo::Output() << "Set: " << optionName << " = " << optionValue << '\n';
+
+    for (auto& option : engine_options)
+    {
+        if (option.getName() != optionName) continue;
+
+        if (!option.setValue(optionValue))
+            return false;
+
+        if (optionName == "NodeMemory")
+            search.set_memory_budget(size_t(option.getIntValue()) << 20);
+        else if (optionName == "MoveOverhead")
+            search.set_move_overhead(std::chrono::milliseconds(option.getIntValue()));
+    }
+
     return true;
 }
 
@@ -73,33 +99,91 @@ bool engine_interface::isInitialized() const {
 
 
 bool engine_interface::setPosition(const std::string &fen, std::string *remain) {
-    auto result = search.initialize(fen);
-    return result;
+    replaying = fen == game_fen && !search.game_has_ended;
+    replayed_moves = 0;
+
+    if (replaying)
+        return true;
+
+    game_fen = fen;
+    game_moves.clear();
+
+    return search.initialize(fen);
 }
 
 bool engine_interface::makeMove(const std::string &move)
 {
-    auto result = search.make_move_external(move);
-    return result;
+    if (replaying && replayed_moves < game_moves.size())
+    {
+        if (game_moves[replayed_moves] == move)
+        {
+            replayed_moves++;
+            return true;
+        }
+
+        // Only the last move differs, its siblings may still be in the tree
+        bool taken_back = replayed_moves + 1 == game_moves.size() && search.take_back();
+
+        if (taken_back)
+            game_moves.pop_back();
+        else if (!restart_game(replayed_moves))
+            return false;
+    }
+
+    if (!search.make_move_external(move))
+        return false;
+
+    game_moves.push_back(move);
+    replayed_moves = game_moves.size();
+    return true;
+}
+
+bool engine_interface::restart_game(size_t moves_kept)
+{
+    game_moves.resize(moves_kept);
+    replaying = false;
+
+    if (!search.initialize(game_fen))
+        return false;
+
+    for (auto& move : game_moves)
+        if (!search.make_move_external(move))
+            return false;
+
+    return true;
+}
+
+void engine_interface::finish_replay()
+{
+    // The last position command ended before the moves played so far, a takeback
+    if (replaying && replayed_moves < game_moves.size())
+    {
+        if (!(replayed_moves + 1 == game_moves.size() && search.take_back()))
+            restart_game(replayed_moves);
+        else
+            game_moves.pop_back();
+    }
+
+    replaying = false;
 }
 
 std::string engine_interface::getFEN() const {
-    return search.current_root->board.to_fen();
+    return search.root_board.to_fen();
 }
 
 void engine_interface::printBoard() const {
-    search.current_root->board.print();
+    search.root_board.print();
 }
 
 bool engine_interface::whiteToMove() const {
-    return !search.current_root->board.flipped;
+    return !search.root_board.flipped;
 }
 
 void engine_interface::clearSearchData() {
 }
 
 void engine_interface::ponderHit() {
-
+    search.ponder_hit();
 }
 
 void engine_interface::setDebug(const bool flag) {
@@ -135,32 +219,68 @@ uint64_t engine_interface::perft(const int depth)
 
 std::string engine_interface::go(const senjo::GoParams &params, std::string *ponder)
 {
-    auto my_time = search.current_root->board.flipped ?params.btime : params.wtime;
-
-    // Only try to do a free operation if there are more than 10 seconds on the clock
-    if (my_time > 10000)
+    finish_replay();
+
+    bool black = search.root_board.flipped;
+
+    mcts::search_limits limits;
+    limits.time_left = std::chrono::milliseconds(black ? params.btime : params.wtime);
+    limits.increment = std::chrono::milliseconds(black ? params.binc : params.winc);
+    limits.movetime = std::chrono::milliseconds(params.movetime);
+    limits.moves_to_go = params.movestogo;
+    limits.nodes = params.nodes;
+    limits.infinite = params.infinite;
+    limits.ponder = params.ponder;
+
+    // Only starts the compaction, the tree is moved in short steps during the search and the opponent's time.
+    // Not while pondering, a miss needs the siblings of the ponder move.
+    if (!params.ponder)
         search.free_memory();
 
     if (search.game_has_ended)
     {
         cout << "info ERROR: search requested but the game has ended, generating new tree without draw states.";
-        auto new_board = search.current_root->board;
+        auto new_board = search.root_board;
         new_board.halfmove_clock = 0;
 
-        search.initialize(new_board.to_fen());
+        game_fen = new_board.to_fen();
+        game_moves.clear();
+        search.initialize(game_fen);
     }
 
-    if (params.infinite)
-        search.expand_tree(std::chrono::years(69), -1);
-    else
-        search.expand_tree(std::chrono::milliseconds(my_time), -1);
+    search.expand_tree(limits);
 
 
     auto best_move = search.best_move();
 
     cout << "Selecting: " << best_move->move.to_uci_move() << " : " << best_move->get_value() << endl;
 
-    return best_move->move.to_uci_move();
+    auto uci_move = best_move->move.to_uci_move();
+
+    // The reply the search spent the most visits on
+    auto reply = best_move->get_node();
+    if (ponder && reply && reply->has_edges())
+    {
+        mcts::edge* expected = nullptr;
+        uint32_t most_visits = 0;
+
+        for (auto& i : *reply)
+        {
+            auto node = i.get_node();
+            if (node && node->visit_count > most_visits)
+            {
+                most_visits = node->visit_count;
+                expected = &i;
+            }
+        }
+
+        if (expected)
+            *ponder = expected->move.to_uci_move();
+    }
+
+    search.resume_compaction();
+
+    return uci_move;
 }
 
 senjo::SearchStats engine_interface::getSearchStats() const {
@@ -32,6 +32,21 @@ struct engine_interface : public senjo::ChessEngine
     std::list<senjo::EngineOption> engine_options;
     bool debug;
 
+    /*
+     * The game of the last position command. A position command that continues it (same FEN, the same moves first)
+     * keeps the tree: the moves it repeats are skipped, new ones advance the root.
+     * A different last move (a ponder miss) takes the root back a move first when it can.
+     * Anything else starts a new tree. A position command with fewer moves than were played (a takeback)
+     * is only applied by the next go, finish_replay.
+     */
+    std::string game_fen;
+    std::vector<std::string> game_moves;
+    size_t replayed_moves = 0;
+    bool replaying = false;
+
+    bool restart_game(size_t moves_kept);
+    void finish_replay();
+
     engine_interface(cxxopts::ParseResult& options);
     virtual std::string getEngineName() const;
 
@@ -0,0 +1,226 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "batch_controller.h"
+
+#include <utils/parking.h>
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+    parking::site inactive_workers_site("inactive workers");
+}
+
+
+mcts::batch_controller::batch_controller(size_t max_batch_size, size_t max_threads, bool enabled) :
+max_batch_size(std::max<size_t>(1, max_batch_size)), min_threshold(std::max<size_t>(1, max_batch_size / 64)),
+max_threads(std::max<uint32_t>(1, max_threads)), enabled(enabled),
+threshold(this->max_batch_size), threads(this->max_threads)
+{
+}
+
+
+void mcts::batch_controller::start(uint64_t nodes_processed)
+{
+    for (auto& i : buckets)
+    {
+        i.batches = 0;
+        i.nodes = 0;
+        i.total_us = 0;
+    }
+
+    window_start = chrono::steady_clock::now();
+    window_nodes = nodes_processed;
+    window_batches = batches;
+
+    state = phase::baseline;
+}
+
+
+void mcts::batch_controller::update(uint64_t nodes_processed)
+{
+    if (!enabled)
+        return;
+
+    auto now = chrono::steady_clock::now();
+    uint64_t total_batches = batches;
+
+    if (now - window_start < window || total_batches - window_batches < min_window_batches)
+        return;
+
+    float rate = (nodes_processed - window_nodes) / chrono::duration<float>(now - window_start).count();
+
+    window_start = now;
+    window_nodes = nodes_processed;
+    window_batches = total_batches;
+
+    switch (state)
+    {
+        case phase::baseline:
+            baseline_rate = rate;
+            failed_steps = 0;
+            probe();
+            break;
+
+        case phase::probing:
+        {
+            bool kept = rate > baseline_rate * (1 + min_gain);
+
+            cout << "info [batch] flush threshold " << flush_threshold() << ", " << threads << "/" << max_threads
+                 << " threads: " << int(rate) << " nodes/s against " << int(baseline_rate)
+                 << (kept ? ", kept" : ", reverted") << endl;
+
+            // A step that paid off is tried again, otherwise the next one
+            if (kept)
+            {
+                baseline_rate = rate;
+                failed_steps = 0;
+            }
+            else
+            {
+                set(before_probe);
+                failed_steps++;
+                next_step = step((int(next_step) + 1) % int(step::count));
+            }
+
+            probe();
+            break;
+        }
+
+        case phase::holding:
+            if (--hold_left <= 0)
+                state = phase::baseline;
+            break;
+    }
+}
+
+
+void mcts::batch_controller::stop()
+{
+    threads = max_threads;
+    parking::notify(threads, inactive_workers_site);
+}
+
+
+void mcts::batch_controller::record_batch(size_t size, chrono::microseconds latency)
+{
+    auto& b = buckets[std::min<size_t>(std::bit_width(std::max<size_t>(1, size)) - 1, max_buckets - 1)];
+
+    b.batches.fetch_add(1, memory_order_relaxed);
+    b.nodes.fetch_add(size, memory_order_relaxed);
+    b.total_us.fetch_add(latency.count(), memory_order_relaxed);
+
+    batches.fetch_add(1, memory_order_relaxed);
+}
+
+
+void mcts::batch_controller::report(ostream& out) const
+{
+    if (!enabled)
+        return;
+
+    for (size_t i = 0; i < max_buckets; i++)
+    {
+        auto n = buckets[i].batches.load(memory_order_relaxed);
+
+        if (n == 0)
+            continue;
+
+        auto nodes = buckets[i].nodes.load(memory_order_relaxed);
+        auto us = std::max<uint64_t>(1, buckets[i].total_us.load(memory_order_relaxed));
+
+        out << "info [batch] size " << (size_t(1) << i) << "-" << (size_t(2) << i) - 1 << ": " << n << " batches, "
+            << us / n << "us each, " << uint64_t(nodes * 1e6 / us) << " nodes/s while evaluating" << endl;
+    }
+
+    out << "info [batch] flush threshold " << flush_threshold() << ", " << threads << "/" << max_threads << " threads" << endl;
+}
+
+
+void mcts::batch_controller::wait_until_active(size_t thread_index)
+{
+    parking::wait_until(threads, [this, thread_index]() {
+        return is_active(thread_index);
+    }, inactive_workers_site);
+}
+
+
+bool mcts::batch_controller::apply(step s)
+{
+    settings next{flush_threshold(), threads};
+
+    switch (s)
+    {
+        case step::larger_batches:
+            next.threshold = std::min(max_batch_size, next.threshold * 2);
+            break;
+        case step::smaller_batches:
+            next.threshold = std::max(min_threshold, next.threshold / 2);
+            break;
+        case step::more_threads:
+            next.threads = std::min(max_threads, next.threads + std::max<uint32_t>(1, next.threads / 4));
+            break;
+        case step::fewer_threads:
+            next.threads = std::max<uint32_t>(1, next.threads - std::max<uint32_t>(1, next.threads / 4));
+            break;
+        default:
+            break;
+    }
+
+    if (next.threshold == flush_threshold() && next.threads == threads)
+        return false;
+
+    set(next);
+    return true;
+}
+
+
+void mcts::batch_controller::set(settings s)
+{
+    threshold = s.threshold;
+    threads = s.threads;
+    parking::notify(threads, inactive_workers_site);
+}
+
+
+void mcts::batch_controller::probe()
+{
+    before_probe = {flush_threshold(), threads};
+
+    // Steps that are out of bounds count as tried
+    for (; failed_steps < int(step::count); failed_steps++)
+    {
+        if (apply(next_step))
+        {
+            state = phase::probing;
+            return;
+        }
+
+        next_step = step((int(next_step) + 1) % int(step::count));
+    }
+
+    cout << "info [batch] holding at flush threshold " << flush_threshold() << ", "
+         << threads << "/" << max_threads << " threads, " << int(baseline_rate) << " nodes/s" << endl;
+
+    state = phase::holding;
+    hold_left = hold_windows;
+}
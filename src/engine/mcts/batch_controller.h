@@ -0,0 +1,126 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_BATCH_CONTROLLER_H
+#define FIREFLY_BATCH_CONTROLLER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace mcts {
+
+    /*
+     * Picks the size at which the shared batch is sent (the flush threshold) and the number of tree traversal threads
+     * that run, whatever evaluates the most nodes per second with this backend, network and machine.
+     *
+     * The search's main loop calls update about every 100ms with the number of nodes evaluated so far.
+     * The controller hill climbs on that rate: it measures a baseline, tries a single step (threshold doubled or halved,
+     * a quarter of the threads more or less), keeps it if the rate went up by more than min_gain and reverts it otherwise.
+     * Once no step helps it holds for a while and starts over, the best settings drift as the tree grows.
+     *
+     * Every forward pass is recorded by batch size (powers of two) for the report.
+     * Disabled, the threshold is max_batch_size and every thread runs.
+     */
+    struct batch_controller
+    {
+        batch_controller(size_t max_batch_size, size_t max_threads, bool enabled);
+
+        // A new search measures from scratch but starts with the settings of the last one
+        void start(uint64_t nodes_processed);
+        void update(uint64_t nodes_processed);
+
+        // Lets every thread run again, inactive threads wait in wait_until_active until then
+        void stop();
+
+        void record_batch(size_t size, std::chrono::microseconds latency);
+        void report(std::ostream& out) const;
+
+        inline size_t flush_threshold() const
+        {
+            return threshold.load(std::memory_order_relaxed);
+        }
+
+        inline bool is_active(size_t thread_index) const
+        {
+            return thread_index < threads.load(std::memory_order_relaxed);
+        }
+
+        void wait_until_active(size_t thread_index);
+
+    private:
+        static constexpr size_t max_buckets = 24;
+        static constexpr std::chrono::milliseconds window{250};
+        static constexpr uint64_t min_window_batches = 4;
+        static constexpr float min_gain = 0.03;
+        static constexpr int hold_windows = 20;
+
+        struct bucket
+        {
+            std::atomic<uint64_t> batches = 0, nodes = 0, total_us = 0;
+        };
+
+        struct settings
+        {
+            size_t threshold;
+            uint32_t threads;
+        };
+
+        enum class step : uint8_t
+        {
+            larger_batches,
+            smaller_batches,
+            more_threads,
+            fewer_threads,
+            count
+        };
+
+        // Returns false if the step would go out of bounds
+        bool apply(step s);
+        void set(settings s);
+        void probe();
+
+        size_t max_batch_size, min_threshold;
+        uint32_t max_threads;
+        bool enabled;
+
+        std::atomic<size_t> threshold;
+        std::atomic<uint32_t> threads; // Watched by inactive threads
+
+        bucket buckets[max_buckets];
+        std::atomic<uint64_t> batches = 0;
+
+        enum class phase : uint8_t
+        {
+            baseline,
+            probing,
+            holding
+        } state = phase::baseline;
+
+        std::chrono::steady_clock::time_point window_start;
+        uint64_t window_nodes = 0, window_batches = 0;
+
+        float baseline_rate = 0;
+        settings before_probe{};
+        step next_step = step::larger_batches;
+        int failed_steps = 0, hold_left = 0;
+    };
+}
+
+#endif //FIREFLY_BATCH_CONTROLLER_H
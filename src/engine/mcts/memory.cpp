@@ -20,99 +20,338 @@
 #include "memory.h"
 
 #include <chrono>
+#include <bit>
+#include <thread>
+#include <algorithm>
 #include "node.h"
 
+#include <stdexcept>
+#include <sys/mman.h>
+
 using namespace std;
 
-memory::memory(size_t max_nn_batch_size, size_t block_size) : block_size(block_size),
-index_in_block(0), current_block(0), max_nn_batch_size(max_nn_batch_size)
+namespace
+{
+    constexpr size_t huge_page_size = 2 * 1024 * 1024;
+    constexpr size_t default_chunk_size = 64 * 1024;
+
+    // Space for the block_header at the start of every block, a whole cache line so nodes don't share it.
+    constexpr size_t block_header_size = 64;
+
+    thread_local memory::allocation_chunk local_chunk;
+    thread_local memory::leaf_recycler local_leaves;
+
+#ifdef MAP_NORESERVE
+    constexpr int reservation_flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#else
+    constexpr int reservation_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#endif
+
+    /*
+     * Every memory instance starts its chunk generations in a range of its own, a new instance at the address
+     * of a destroyed one would otherwise accept the stale chunks that threads still hold.
+     */
+    std::atomic<uint32_t> instances = 0;
+
+    /*
+     * Trims a mapping of size + alignment bytes down to size bytes starting at an aligned address
+     */
+    byte* trim_to_alignment(void* mapping, size_t alignment, size_t size)
+    {
+        auto start = (byte*)mapping;
+        auto aligned = (byte*)(((uintptr_t)start + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        auto end = start + size + alignment;
+
+        if (aligned != start)
+            munmap(start, aligned - start);
+        if (aligned + size != end)
+            munmap(aligned + size, end - (aligned + size));
+
+        return aligned;
+    }
+}
+
+memory::memory(size_t max_nn_batch_size, size_t block_size, bool huge_pages, size_t node_alignment, numa::placement placement) :
+placement(placement), block_size(block_size), max_nn_batch_size(max_nn_batch_size),
+node_alignment(std::bit_ceil(std::clamp<size_t>(node_alignment, 16, 256))), huge_pages(huge_pages),
+chunk_generation(instances.fetch_add(1) << 20)
 {
+#ifndef __linux__
+    this->huge_pages = false;
+#endif
+
+    if (this->huge_pages)
+        this->block_size = std::max(this->block_size, huge_page_size);
+
+    this->block_size = std::bit_ceil(std::max<size_t>(this->block_size, 1024 * 1024));
+
+    chunk_size = std::min(default_chunk_size, this->block_size / 16);
+
+    // Only address space until blocks are mapped into it, the kernel doesn't commit memory for it
+    auto handle_shift = std::countr_zero(this->node_alignment);
+    region_size = std::min((size_t(1) << 32) << handle_shift, region_alignment);
+
+    auto reservation = mmap(nullptr, region_size + region_alignment, PROT_NONE, reservation_flags, -1, 0);
+    if (reservation == MAP_FAILED)
+        throw std::runtime_error("Failed to reserve address space for the node memory");
+
+    region = trim_to_alignment(reservation, region_alignment, region_size);
+
+    if (mmap(region, sizeof(region_header), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED)
+        throw std::runtime_error("Failed to map the node memory region header");
+
+    ((region_header*)region)->handle_shift = handle_shift;
+
+    if (numa::get_topology().nodes() == 1)
+        this->placement = numa::placement::none;
+
+    arenas.resize(this->placement == numa::placement::local ? numa::get_topology().nodes() : 1);
+
     blocks.reserve(256);
-    sys_malloc_new_block();
+    block_backings.reserve(256);
+
+    for (size_t i = 0; i < arenas.size(); i++)
+        sys_malloc_new_block(int(i));
 
     transposition_table.reserve(1e+8);
+
+    clear();
+
+    report_pages();
+
+    // Larger budgets are clamped to this, see set_budget
+    cout << "info [memory] Handles address at most " << max_region_blocks() * (this->block_size / (1024 * 1024))
+         << " MiB of nodes with " << this->node_alignment << "-byte node alignment" << endl;
 }
 
 memory::~memory() {
     sys_free_memory();
 }
 
-mcts::node* memory::allocate_fused_node_lockless(size_t edge_count)
+
+bool memory::next_block(size_t arena_index)
 {
-    size_t required_memory = sizeof(mcts::node) + sizeof(mcts::edge) * edge_count;
+    auto numa_node = int(arena_index);
+
+    // The search notices and stops expanding, see search::expand_tree
+    if (free_blocks.empty() && !sys_malloc_new_block(numa_node))
+    {
+        exhausted = true;
+        return false;
+    }
+
+    // Free blocks come back from every arena, take the most recent one that's already on this node
+    auto free_index = free_blocks.size() - 1;
 
-    if ((index_in_block + required_memory) >= block_size)
+    if (placement == numa::placement::local)
     {
-        current_block++;
-        index_in_block = 0;
+        for (size_t i = free_blocks.size(); i-- > 0;)
+            if (get_header(free_blocks[i])->numa_node == numa_node)
+            {
+                free_index = i;
+                break;
+            }
     }
 
-    auto memory = blocks[current_block] + index_in_block;
-    index_in_block += required_memory;
+    auto block = free_blocks[free_index];
+    free_blocks.erase(free_blocks.begin() + free_index);
 
-    return (mcts::node*)memory;
+    if (placement == numa::placement::local && get_header(block)->numa_node != numa_node)
+    {
+        numa::bind_memory(blocks[block], block_size, numa_node, true);
+        get_header(block)->numa_node = numa_node;
+    }
+
+    auto& arena = arenas[arena_index];
+    arena.current_block = block;
+    // Nodes stay aligned even with an alignment larger than the header, handles can't address anything in between
+    arena.index_in_block = align_node_size(block_header_size);
+
+    get_header(block)->state = used_block;
+    get_header(block)->liveness_epoch = liveness_epoch;
+    used_blocks.push_back(block);
+    return true;
 }
 
 
-mcts::node* memory::allocate_fused_node(size_t edge_count)
+std::byte* memory::allocate_from_blocks(size_t size)
 {
-    size_t required_memory = sizeof(mcts::node) + sizeof(mcts::edge) * edge_count;
+    size = align_node_size(size);
+
+    auto arena_index = placement == numa::placement::local ? numa::current_node() % arenas.size() : 0;
+    auto& arena = arenas[arena_index];
+
+    if ((arena.index_in_block + size) >= block_size && !next_block(arena_index))
+        return nullptr;
+
+    auto memory = blocks[arena.current_block] + arena.index_in_block;
+    arena.index_in_block += size;
+
+    return memory;
+}
 
-    std::lock_guard lock(memory_lock);
 
-    if ((index_in_block + required_memory) >= block_size)
+std::byte* memory::allocate_from_chunk(allocation_chunk& chunk, size_t size)
+{
+    size = align_node_size(size);
+
+    if (chunk.owner != this ||
+        chunk.generation != chunk_generation.load(std::memory_order_acquire) ||
+        (size_t)(chunk.end - chunk.next) < size) [[unlikely]]
     {
-        current_block++;
-        index_in_block = 0;
-
-        // TODO: The engine doesn't necessarily need to crash if it runs out of memory.
-        // One solution would be to halt all tree traversal and do a free operation.
-        // Another solution would be to stop searching and just return the best move found so far.
-        if (current_block >= blocks.size()) {
-            if (!sys_malloc_new_block())
-            {
-                throw std::logic_error("[memory] malloc failed.");
-            }
-        }
+        std::lock_guard lock(memory_lock);
+
+        // Too large for a chunk, never happens with legal chess positions
+        if (size > chunk_size)
+            return allocate_from_blocks(size);
+
+        // The rest of the old chunk is wasted, same as the tail of a block
+        chunk.owner = this;
+        chunk.generation = chunk_generation.load(std::memory_order_relaxed);
+        auto memory = allocate_from_blocks(chunk_size);
+        if (memory == nullptr)
+            return nullptr;
+
+        chunk.next = memory;
+        chunk.end = memory + chunk_size;
     }
 
-    auto memory = blocks[current_block] + index_in_block;
-    index_in_block += required_memory;
+    auto memory = chunk.next;
+    chunk.next += size;
+
+    return memory;
+}
 
 
-    return (mcts::node*)memory;
+mcts::node* memory::allocate_fused_node(size_t edge_count)
+{
+    return (mcts::node*)allocate_from_chunk(local_chunk, sizeof(mcts::node) + sizeof(mcts::edge) * edge_count);
 }
 
 
+void memory::set_traversal_threads(size_t n_threads)
+{
+    recycling_slots = std::make_unique<recycling_slot[]>(n_threads);
+    n_recycling_slots = n_threads;
+
+    for (size_t i = 0; i < n_threads; i++)
+        recycling_slots[i].epoch = idle_epoch;
+}
 
-mcts::node* memory::free_unused(mcts::node* new_root, std::vector<std::unique_ptr<mcts::node>>& erased_parents)
+
+void memory::begin_traversals(size_t thread_index)
 {
-    auto time_start = chrono::high_resolution_clock::now();
+    if (thread_index >= n_recycling_slots)
+        return;
 
     /*
-     *  Backup the history of the position in an external memory structure
-     *  This is necessary for threefold repetition detection and EncodePositionForNN history planes.
-     *  Edges are not preserved.
+     * The thread only finds nodes through the tree from now on, so whatever was retired before is out of its reach.
+     * The epoch is read again in case a leaf was retired by a thread that still saw this one as idle.
      */
+    auto& slot = recycling_slots[thread_index].epoch;
+    uint64_t epoch;
 
-    static vector<mcts::node*> history;
+    do
+    {
+        epoch = recycling_epoch.load();
+        slot.store(epoch);
+    } while (recycling_epoch.load() != epoch);
+}
 
 
-    auto node = new_root->parent;
+void memory::end_traversals(size_t thread_index)
+{
+    if (thread_index < n_recycling_slots)
+        recycling_slots[thread_index].epoch.store(idle_epoch);
+}
+
 
-    while (node)
+void memory::traversals_quiescent(size_t thread_index)
+{
+    if (thread_index < n_recycling_slots)
+        recycling_slots[thread_index].epoch.store(recycling_epoch.load());
+}
+
+
+memory::leaf_recycler& memory::local_recycler()
+{
+    if (local_leaves.owner != this || local_leaves.generation != chunk_generation.load(std::memory_order_acquire)) [[unlikely]]
     {
-        history.push_back(node);
+        // The leaves may be in blocks that are being freed or moved, they're left to the compaction
+        std::lock_guard lock(memory_lock);
+
+        local_leaves.owner = this;
+        local_leaves.generation = chunk_generation.load(std::memory_order_relaxed);
+        local_leaves.liveness_epoch = liveness_epoch;
+        local_leaves.safe_epoch = 0;
+        local_leaves.retired.clear();
+    }
+
+    return local_leaves;
+}
+
+
+void memory::retire_leaf(mcts::node* leaf)
+{
+    auto& recycler = local_recycler();
+    auto header = get_header(leaf);
 
-        if (node == get_root()) break;
+    // A block counted by the pruner or in from-space may be freed with the header still in the list
+    if (header->state != used_block || header->liveness_epoch != recycler.liveness_epoch)
+        return;
 
-        node = node->parent;
+    recycler.retired.emplace_back(leaf, recycling_epoch.fetch_add(1) + 1);
+}
+
+
+mcts::node* memory::allocate_leaf()
+{
+    auto& recycler = local_recycler();
+
+    if (!recycler.retired.empty())
+    {
+        auto [leaf, epoch] = recycler.retired.front();
+
+        // Every thread has been quiescent since safe_epoch, idle threads only up to now
+        if (epoch > recycler.safe_epoch)
+        {
+            recycler.safe_epoch = recycling_epoch.load();
+
+            for (size_t i = 0; i < n_recycling_slots; i++)
+                recycler.safe_epoch = std::min(recycler.safe_epoch, recycling_slots[i].epoch.load());
+        }
 
+        if (epoch <= recycler.safe_epoch)
+        {
+            recycler.retired.pop_front();
+            return leaf;
+        }
     }
 
+    return allocate_fused_node(0);
+}
+
+
+
+void memory::erase_parents(mcts::node* root, std::vector<std::unique_ptr<mcts::node>>& erased_parents)
+{
+    /*
+     *  Backup the history of the position in an external memory structure
+     *  rebuild_root_history still reads their repetition counts for threefold repetition detection,
+     *  the positions themselves are kept by the search. Edges are not preserved.
+     */
+
+    static vector<mcts::node*> history;
+
+    // Everything up to the first already erased parent is still in the arena
+    auto first_erased = erased_parents.empty() ? nullptr : erased_parents.back().get();
+
+    for (auto node = root->parent; node && node != first_erased; node = node->parent)
+        history.push_back(node);
+
     while(!history.empty())
     {
-        node = history.back();
+        auto node = history.back();
         history.pop_back();
         erased_parents.push_back(make_unique<mcts::node>(*node));
 
@@ -122,168 +361,560 @@ mcts::node* memory::free_unused(mcts::node* new_root, std::vector<std::unique_pt
         if (!history.empty())
             history.back()->parent = erased_parents.back().get();
         else
-            new_root->parent = erased_parents.back().get();
+            root->parent = erased_parents.back().get();
     }
+}
+
+
+mcts::node* memory::begin_compaction(mcts::node* new_root, std::vector<std::unique_ptr<mcts::node>>& erased_parents)
+{
+    auto time_start = chrono::high_resolution_clock::now();
 
+    // Nowhere to move the tree to, with a budget the surviving tree could take up to everything in use
+    if (available_bytes() < arenas.size() * block_size || (has_budget() && available_bytes() < used_bytes()))
+        return new_root;
 
+    erase_parents(new_root, erased_parents);
 
 
-    //region Shift all still viable nodes to blocks[0] + 0
+    //region Turn every block in use into from-space
 
-    size_t previous_bytes = current_block * block_size + index_in_block;
-    // Reset indices
-    clear();
+    std::lock_guard lock(memory_lock);
+
+    for (auto i : used_blocks)
+    {
+        get_header(i)->state = from_space_block;
+        from_space_blocks.push_back(i);
+    }
+    used_blocks.clear();
 
+    compaction_queue.clear();
+    selective_compaction = false;
+    compaction_moved_nodes = 0;
+    compaction_steps = 0;
+    compaction_time = {};
 
-    auto new_root_memory = allocate_fused_node_lockless(new_root->edge_count);
-    // Copy root to start
-    memcpy(new_root_memory, new_root, sizeof(mcts::node) + sizeof(mcts::edge) * new_root->edge_count);
+    chunk_generation.fetch_add(1, std::memory_order_release);
+    for (size_t i = 0; i < arenas.size(); i++)
+        next_block(i);
 
+    transposition_generation++;
 
-    static vector<mcts::node*> nodes_to_fix;
+    //endregion
 
 
-    // Parse all nodes that need to be moved
+    auto new_root_memory = (mcts::node*)allocate_from_blocks(new_root->get_total_size());
+    // Copy root to start
+    memcpy(static_cast<void*>(new_root_memory), new_root, new_root->get_total_size());
 
-    size_t last_layer_size = 0;
     // Fix references to root in children
     for (auto& i : *new_root_memory) {
         if (i.get_node()) {
             i.get_node()->parent = new_root_memory;
-            nodes_to_fix.push_back(i.node_);
-            last_layer_size++;
+            compaction_queue.push_back(i.get_node());
         }
     }
 
-    if (!last_layer_size)
-        return new_root_memory;
+    compaction_time += chrono::high_resolution_clock::now() - time_start;
 
+    if (compaction_queue.empty())
+        release_from_space();
 
-    static vector<vector<mcts::node*>> partitioned_nodes_to_fix;
-    partitioned_nodes_to_fix.resize(blocks.size());
+    return new_root_memory;
+}
 
-    for (auto& i : nodes_to_fix)
-        partitioned_nodes_to_fix[get_parent_block_index(i)].push_back(i);
 
-    // Parse all nodes in subtree, layer by layer
-    while (last_layer_size)
+void memory::relocate_subtrees(std::vector<mcts::node*>& stack, allocation_chunk& chunk,
+                               std::chrono::high_resolution_clock::time_point deadline,
+                               std::vector<std::pair<uint64_t, mcts::node*>>& relocated)
+{
+    size_t count = 0;
+
+    /*
+     * Depth first, so every subtree ends up in contiguous memory.
+     * Parents are always moved before their children, copy_to relies on the parent's edges being in place.
+     */
+    while (!stack.empty())
     {
-        auto start = nodes_to_fix.size() - last_layer_size;
-        auto end = nodes_to_fix.size();
-        last_layer_size = 0;
+        if ((++count & 63) == 0 && chrono::high_resolution_clock::now() >= deadline)
+            break;
+
+        auto node = stack.back();
 
-        for (; start < end; start++)
+        // Only part of the tree is in from-space, the rest is just walked through
+        if (selective_compaction && !in_from_space(node))
         {
-            for (auto& i : *nodes_to_fix[start])
+            stack.pop_back();
+
+            for (auto& i : *node)
+                if (i.get_node())
+                    stack.push_back(i.get_node());
+            continue;
+        }
+
+        // Out of budget, the node stays in from-space until the tree is cleared
+        auto moved = (mcts::node*)allocate_from_chunk(chunk, node->get_total_size());
+        if (moved == nullptr)
+            break;
+
+        stack.pop_back();
+        node->copy_to(moved);
+
+        relocated.emplace_back(moved->position_hash, moved);
+
+        // Children expanded since the compaction started are already outside of from-space
+        for (auto& i : *moved)
+        {
+            if (i.get_node() && (selective_compaction || in_from_space(i.get_node())))
+                stack.push_back(i.get_node());
+        }
+    }
+}
+
+
+bool memory::compaction_step(std::chrono::high_resolution_clock::time_point deadline, size_t n_threads)
+{
+    if (!is_compacting())
+        return true;
+
+    auto time_start = chrono::high_resolution_clock::now();
+
+    n_threads = std::max<size_t>(1, std::min(n_threads, compaction_queue.size()));
+
+    compaction_stacks.resize(std::max(compaction_stacks.size(), n_threads));
+    compaction_relocated.resize(std::max(compaction_relocated.size(), n_threads));
+    compaction_chunks.resize(std::max(compaction_chunks.size(), n_threads));
+
+    // Deal the pending subtrees out, neighbouring subtrees usually differ in size a lot
+    for (size_t i = 0; i < compaction_queue.size(); i++)
+        compaction_stacks[i % n_threads].push_back(compaction_queue[i]);
+    compaction_queue.clear();
+
+    {
+        std::vector<std::jthread> helpers;
+        for (size_t t = 1; t < n_threads; t++)
+            helpers.emplace_back([&, t]() {
+                relocate_subtrees(compaction_stacks[t], compaction_chunks[t], deadline, compaction_relocated[t]);
+            });
+
+        relocate_subtrees(compaction_stacks[0], compaction_chunks[0], deadline, compaction_relocated[0]);
+    }
+
+    {
+        std::lock_guard lock(transposition_table_lock);
+
+        for (size_t t = 0; t < n_threads; t++)
+        {
+            compaction_moved_nodes += compaction_relocated[t].size();
+
+            for (auto& [hash, node] : compaction_relocated[t])
             {
-                node = i.get_node();
-                if (node) {
-                    nodes_to_fix.push_back(node);
-                    partitioned_nodes_to_fix[get_parent_block_index(node)].push_back(node);
-                    last_layer_size++;
-                }
+                auto entry = transposition_table.find(hash);
+
+                if (entry != transposition_table.end())
+                    entry->second = {node, transposition_generation};
+                else if (transposition_table.size() < max_transpositions)
+                    transposition_table.emplace(hash, transposition_entry{node, transposition_generation});
             }
+            compaction_relocated[t].clear();
+
+            // Whatever didn't make the deadline is picked up by the next step
+            compaction_queue.insert(compaction_queue.end(), compaction_stacks[t].begin(), compaction_stacks[t].end());
+            compaction_stacks[t].clear();
         }
     }
-    cout << "info Copying " << nodes_to_fix.size() << " nodes." << endl;
 
+    compaction_steps++;
+    compaction_time += chrono::high_resolution_clock::now() - time_start;
 
-    //transposition_table.clear();
+    if (!compaction_queue.empty())
+        return false;
 
-    /*
-     * Since the tree is expected to grow unpredictably, it's necessary to sort the addresses in ascending order.
-     * Otherwise, nodes at lower addresses would likely get overwritten by nodes at higher addresses that just
-     * happened to be added to the queue first.
-     *
-     * Or it would work like that, if malloc returned ascending addresses, however since (blocks[2] < blocks[0])
-     * may be true, nodes must be sorted by their block indices primarily and by their addresses secondarily.
-     */
-    for (auto& i : partitioned_nodes_to_fix)
-        sort(i.begin(), i.end());
+    std::lock_guard lock(memory_lock);
+    release_from_space();
+
+    return true;
+}
+
+
+void memory::release_from_space()
+{
+    cout << "info [memory] Moved " << compaction_moved_nodes << " nodes in " << compaction_steps << " steps, " <<
+         chrono::duration_cast<chrono::milliseconds>(compaction_time).count() << "ms, freed " <<
+         (from_space_blocks.size() * block_size) / 1024 << " kb of memory." << endl;
+
+    for (auto i : from_space_blocks)
+    {
+        get_header(i)->state = free_block;
+        free_blocks.push_back(i);
+    }
+    from_space_blocks.clear();
+    selective_compaction = false;
+
+    exhausted = false;
+}
+
+
+void memory::begin_liveness(mcts::node* root, std::vector<std::unique_ptr<mcts::node>>& erased_parents)
+{
+    erase_parents(root, erased_parents);
+
+    std::lock_guard lock(memory_lock);
+
+    liveness_epoch++;
+    live_bytes.assign(blocks.size(), 0);
+
+    // The current blocks and every thread's chunk keep taking allocations, so they can't be counted
+    for (auto& arena : arenas)
+        get_header(arena.current_block)->liveness_epoch = liveness_epoch;
+    chunk_generation.fetch_add(1, std::memory_order_release);
+}
+
+
+void memory::count_live(const mcts::node* node)
+{
+    auto index = get_parent_block_index(node);
+
+    // Blocks allocated after begin_liveness are excluded anyway
+    if (index < live_bytes.size())
+        live_bytes[index] += align_node_size(node->get_total_size());
+}
+
+
+void memory::reclaim_blocks(const mcts::node* root)
+{
+    std::lock_guard lock(memory_lock);
 
-    // TODO: Nodes occupying contiguous memory could be fused and copied in a single memcpy call
-    // This might be a performance improvement.
+    auto root_block = get_parent_block_index(root);
 
-    // Do the actual copying
-    for (auto& partition : partitioned_nodes_to_fix) {
-        for (int i = 0; i < partition.size(); i++) {
-            node = partition[i];
-            auto memory = allocate_fused_node_lockless(node->edge_count);
+    size_t freed_blocks = 0;
+    std::vector<std::pair<size_t, uint32_t>> sparse_blocks;
 
-            transposition_table[node->board.hash()] = memory;
-            node->copy_to(memory);
+    for (size_t i = 0; i < used_blocks.size();)
+    {
+        auto block = used_blocks[i];
+        auto header = get_header(block);
+
+        if (header->liveness_epoch >= liveness_epoch || block == root_block || block >= live_bytes.size())
+        {
+            i++;
+            continue;
+        }
+
+        if (live_bytes[block] == 0)
+        {
+            header->state = free_block;
+            free_blocks.push_back(block);
+
+            used_blocks[i] = used_blocks.back();
+            used_blocks.pop_back();
+            freed_blocks++;
+            continue;
         }
-        partition.clear();
+
+        if (live_bytes[block] < block_size / 2)
+            sparse_blocks.emplace_back(live_bytes[block], block);
+
+        i++;
+    }
+
+    if (freed_blocks)
+    {
+        exhausted = false;
+
+        // Entries may point into the freed blocks, which the next allocations reuse
+        std::lock_guard transposition_lock(transposition_table_lock);
+        transposition_generation++;
     }
-    nodes_to_fix.clear();
 
-    size_t current_bytes = current_block * block_size + index_in_block;
+    // Move the nodes out of the sparsest blocks first, keeping two blocks for the search
+    std::sort(sparse_blocks.begin(), sparse_blocks.end());
 
-    cout << "info [memory] Freed " << (previous_bytes - current_bytes) / 1024 << " kb of memory in " <<
-         chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - time_start).count()  << "ms." << endl;
+    size_t allocatable = max_blocks ? (max_blocks > blocks.size() ? max_blocks - blocks.size() : 0) : SIZE_MAX / 2 / block_size;
+    size_t room = (free_blocks.size() + allocatable) * block_size;
+    room = room > 2 * block_size ? room - 2 * block_size : 0;
 
-    return new_root_memory;
-    //endregion
+    size_t bytes_to_move = 0;
+
+    for (auto [live, block] : sparse_blocks)
+    {
+        // Chunk tails are lost when moving as well
+        auto cost = live + live / 8;
+        if (bytes_to_move + cost > room) break;
+        bytes_to_move += cost;
+
+        get_header(block)->state = from_space_block;
+        from_space_blocks.push_back(block);
+        used_blocks.erase(std::find(used_blocks.begin(), used_blocks.end(), block));
+    }
+
+    cout << "info [memory] Freed " << freed_blocks << " dead block(s), compacting " << from_space_blocks.size() <<
+         " sparse block(s) holding " << bytes_to_move / 1024 << " kb." << endl;
+
+    if (from_space_blocks.empty())
+        return;
+
+    selective_compaction = true;
+    compaction_queue.assign(1, (mcts::node*)root);
+    compaction_moved_nodes = 0;
+    compaction_steps = 0;
+    compaction_time = {};
+
+    std::lock_guard transposition_lock(transposition_table_lock);
+    transposition_generation++;
 }
 
 
 void memory::clear() {
-    current_block = 0;
-    index_in_block = 0;
+    compaction_queue.clear();
+    from_space_blocks.clear();
+    used_blocks.clear();
+    free_blocks.clear();
+
+    // Reversed, so blocks are handed out in ascending order
+    for (size_t i = blocks.size(); i-- > 0;)
+    {
+        get_header(i)->state = free_block;
+        free_blocks.push_back(i);
+    }
+
+    chunk_generation.fetch_add(1, std::memory_order_release);
+    exhausted = false;
+    for (size_t i = 0; i < arenas.size(); i++)
+        next_block(i);
+
     transposition_table.clear();
 }
 
 
-bool memory::sys_malloc_new_block()
+bool memory::sys_map_block(std::byte* memory, block_backing& backing)
 {
-    auto memory = malloc(block_size);
-    if (memory == nullptr) return false;
-    blocks.push_back((byte*)memory);
+#ifdef __linux__
+    // Explicit huge pages, only succeeds if enough pages are reserved in /proc/sys/vm/nr_hugepages
+    if (huge_pages && mmap(memory, block_size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1, 0) != MAP_FAILED)
+    {
+        backing = hugetlb_backed;
+        return true;
+    }
+#endif
+
+    // Replaces the reserved range, even if the failed attempt above already removed it
+    if (mmap(memory, block_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED)
+        return false;
+
+#ifdef __linux__
+    // Transparent huge pages, the block size is a multiple of the huge page size so the whole block can use them
+    if (huge_pages)
+    {
+        madvise(memory, block_size, MADV_HUGEPAGE);
+        backing = thp_backed;
+        return true;
+    }
+#endif
+
+    backing = plain_backed;
     return true;
 }
 
-void memory::sys_free_memory() {
-    for (auto& i : blocks)
-        free(i);
-    blocks.clear();
 
-    for (auto& i : batch_intermediate_memory)
-        free(i);
+bool memory::sys_malloc_new_block(int numa_node)
+{
+    if (max_blocks && blocks.size() >= max_blocks)
+        return false;
 
-    batch_intermediate_memory.clear();
+    // Out of node handles
+    if (blocks.size() >= max_region_blocks())
+        return false;
+
+    auto memory = region + (blocks.size() + 1) * block_size;
+    block_backing backing;
+    if (!sys_map_block(memory, backing)) return false;
+
+    // Before the header write below, the first touch already has to follow the policy
+    bool placed = false;
+
+    if (placement == numa::placement::local)
+        placed = numa::bind_memory(memory, block_size, numa_node, false);
+    else if (placement == numa::placement::interleave)
+        numa::interleave_memory(memory, block_size, false);
+
+    *(block_header*)memory = {(uint32_t)blocks.size(), free_block, 0, placed ? numa_node : -1};
+
+    free_blocks.push_back(blocks.size());
+    blocks.push_back(memory);
+    block_backings.push_back(backing);
+    return true;
+}
+
+void memory::set_budget(size_t budget)
+{
+    std::lock_guard lock(memory_lock);
+
+    max_blocks = budget ? std::max<size_t>(2, budget / block_size) : 0;
+
+    if (max_blocks > max_region_blocks())
+    {
+        cout << "info [memory] Node memory budget of " << budget / (1024 * 1024) << " MiB is more than the "
+             << max_region_blocks() * (block_size / (1024 * 1024)) << " MiB handles can address with " << node_alignment
+             << "-byte node alignment" << (node_alignment < 256 ? ", a larger --node_alignment addresses more" : "") << endl;
+        max_blocks = max_region_blocks();
+    }
+
+    if (max_blocks)
+        cout << "info [memory] Node memory budget: " << max_blocks * block_size / (1024 * 1024) << " MiB" << endl;
+
+    exhausted = false;
+}
+
+size_t memory::max_region_blocks() const
+{
+    return region_size / block_size - 1;
+}
+
+size_t memory::used_bytes() const
+{
+    std::lock_guard lock(memory_lock);
+    return (used_blocks.size() + from_space_blocks.size()) * block_size;
+}
+
+size_t memory::available_bytes() const
+{
+    if (!max_blocks)
+        return SIZE_MAX;
+
+    std::lock_guard lock(memory_lock);
+
+    size_t allocatable = max_blocks > blocks.size() ? max_blocks - blocks.size() : 0;
+
+    return (free_blocks.size() + allocatable) * block_size;
+}
+
+int memory::hashfull() const
+{
+    std::lock_guard lock(memory_lock);
+
+    auto capacity = max_blocks ? max_blocks : blocks.size();
+    return std::min<size_t>(1000, (used_blocks.size() + from_space_blocks.size()) * 1000 / capacity);
+}
+
+bool memory::near_budget() const
+{
+    if (!max_blocks)
+        return exhausted;
+
+    // Enough headroom for the nodes created until the search notices, at least two blocks
+    auto reserve = std::max(2 * block_size, max_blocks * block_size / 64);
+
+    return exhausted || available_bytes() < reserve;
 }
 
 
-const int memory::get_parent_block_index(const mcts::node *node)
+void memory::report_pages() const
 {
-    byte* n = (byte*)node;
-    for (int i = 0; i < blocks.size(); i++)
+    size_t hugetlb_blocks = 0, thp_blocks = 0;
+
+    for (auto backing : block_backings)
     {
-        if (blocks[i] <= n && (blocks[i] + block_size) > n)
-            return i;
+        if (backing == hugetlb_backed) hugetlb_blocks++;
+        else if (backing == thp_backed) thp_blocks++;
     }
 
-    throw std::logic_error("[memory fault] node is not in any block.");
+    cout << "info [memory] " << blocks.size() << " block(s) of " << block_size / (1024 * 1024) << " MiB, "
+         << hugetlb_blocks * (block_size / huge_page_size) << " explicit huge pages, "
+         << thp_blocks << " block(s) advised for transparent huge pages";
+
+    if (!huge_pages)
+        cout << " (huge pages disabled)";
+
+    if (placement == numa::placement::interleave)
+        cout << ", interleaved over " << numa::get_topology().nodes() << " NUMA nodes";
+    else if (placement == numa::placement::local)
+        cout << ", one arena per NUMA node";
+
+    cout << endl;
+}
+
+void memory::sys_free_memory() {
+    // Every block is mapped inside the region
+    if (region)
+        munmap(region, region_size);
+
+    region = nullptr;
+    blocks.clear();
+    block_backings.clear();
+    free_blocks.clear();
+    used_blocks.clear();
+    from_space_blocks.clear();
+
+    for (auto& i : batch_intermediate_memory)
+        free(i);
+
+    batch_intermediate_memory.clear();
 }
 
 
-mcts::node *memory::transposition_check(mcts::node *node) {
+mcts::node *memory::transposition_check(mcts::node *node, chess::board const& board) {
 
     mcts::node* result;
     {
         std::lock_guard lock(transposition_table_lock);
-        result = transposition_table[node->board.hash()];
+        auto entry = transposition_table.find(node->position_hash);
 
-        //|| result->repetitions != node->repetitions
-        if (!result || result->board != node->board) {
-            result = node;
+        if (entry == transposition_table.end() || entry->second.generation != transposition_generation)
             return nullptr;
-        }
 
-        //if (!result->evaluated)
-        //    return nullptr;
+        result = entry->second.node;
     }
-    //result->lock();
+
+    if (!result || !result->has_edges())
+        return nullptr;
+
+    /*
+     * Boards aren't stored, so make sure a hash collision didn't hit a different position by comparing the moves.
+     * Evaluated nodes have their edges sorted by prior, hence the order independent fingerprint.
+     */
+    chess::movegen_result moves;
+    board.generate_moves(moves);
+
+    // A remainder edge stands for at least two moves that weren't kept, see mcts::node::materialize
+    size_t n_kept = result->edge_count - result->has_remainder();
+
+    if (n_kept != result->edge_count)
+    {
+        if (n_kept + 2 > moves.moves_count)
+            return nullptr;
+
+        for (auto& i : *result)
+            if (!i.is_remainder() && std::find(moves.moves, moves.moves + moves.moves_count, i.move) == moves.moves + moves.moves_count)
+                return nullptr;
+
+        return result;
+    }
+
+    if (result->edge_count != moves.moves_count)
+        return nullptr;
+
+    // The fingerprint of the stored edges is added and the one of the generated moves taken away again
+    uint64_t sum = 0, x = 0;
+
+    for (auto& i : *result)
+    {
+        auto m = std::bit_cast<uint16_t>(i.move);
+        sum += m;
+        x ^= uint64_t(m) * 0x9E3779B97F4A7C15;
+    }
+
+    for (size_t i = 0; i < moves.moves_count; i++)
+    {
+        auto m = std::bit_cast<uint16_t>(moves.moves[i]);
+        sum -= m;
+        x ^= uint64_t(m) * 0x9E3779B97F4A7C15;
+    }
+
+    if (sum != 0 || x != 0)
+        return nullptr;
+
     return result;
 }
 
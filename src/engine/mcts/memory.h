@@ -22,54 +22,219 @@
 
 #include <cstdint>
 #include <vector>
+#include <deque>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <utils/numa.h>
 
 namespace mcts
 {
     struct node;
 };
 
+namespace chess
+{
+    struct board;
+};
+
 /*
- * This memory manager works by allocating large chunks of memory (1MB by default)
+ * This memory manager works by allocating large chunks of memory (8MB by default)
  * and dynamically allocating every node and its edges in contiguous memory.
  *
- * Freeing is done by copying all important nodes to the beginning of all memory,
- * overwriting any dead nodes and making all memory immediately following
- * blocks[0] + sizeof(copied_nodes) available for new allocations.
+ * On Linux blocks are mapped with explicit huge pages (MAP_HUGETLB) when the system has them reserved,
+ * otherwise they are advised for transparent huge pages,
+ * tree descent touches nodes all over the arena, so 4KB pages make it miss the TLB constantly.
+ * Blocks are aligned to their (power of two) size and start with their own index,
+ * so finding the block of any node is a single load.
+ * Every instance maps its blocks into an address range of its own, see from_handle.
+ *
+ * Traversal threads don't take memory_lock for every node, each thread bump-allocates from its own
+ * chunk (64KB by default) carved out of the current block and only locks to grab the next chunk.
+ * Chunks never cross block boundaries, so every node still lies within a single block.
+ *
+ * Nodes start at node_alignment (a cache line by default), see the statistics region of mcts::node.
+ * That pads every node to a multiple of 64 bytes, 28 bytes on average and 24 for every 40-byte leaf,
+ * an alignment of 16 packs them instead.
+ *
+ * Freeing is done by evacuation, every block in use becomes from-space and the surviving subtree
+ * is copied into free blocks in bounded steps, the search can run between steps.
+ * Once nothing live is left in from-space, its blocks are reused for new allocations.
+ *
+ * Edges refer to their children by 32-bit handles instead of pointers, see from_handle.
+ *
+ * On NUMA machines blocks can be interleaved over every node, or with local placement every node gets
+ * an arena (a current block) of its own and chunks are carved from the arena of the node the thread runs on.
+ * Free blocks keep their node and are handed back to the same node's arena where possible.
  */
 struct memory {
 
+    /*
+     * Bump allocation region owned by a single thread
+     */
+    struct allocation_chunk
+    {
+        const memory* owner = nullptr;
+        uint32_t generation = 0;
+        std::byte* next = nullptr;
+        std::byte* end = nullptr;
+    };
+
+    /*
+     * Bare leaf headers retired by a single thread, oldest first, with the recycling epoch they were retired in
+     */
+    struct leaf_recycler
+    {
+        const memory* owner = nullptr;
+        uint32_t generation = 0, liveness_epoch = 0;
+        uint64_t safe_epoch = 0;
+        std::deque<std::pair<mcts::node*, uint64_t>> retired;
+    };
+
 
     /*
      * Initializes the memory manager with a block size and allocates an initial block.
+     * The block size is rounded up to a power of two (and at least the huge page size with huge_pages).
+     * The node alignment is rounded up to a power of two between 16 and 256 bytes, it's the unit of node handles.
      */
-    memory(size_t max_nn_batch_size=2048, size_t block_size = 8388608 /* 8 MiB */);
+    memory(size_t max_nn_batch_size=2048, size_t block_size = 8388608 /* 8 MiB */, bool huge_pages = true,
+           size_t node_alignment = 64, numa::placement placement = numa::placement::none);
     ~memory();
 
+
+    //region Node handles
+
     /*
-     * The new root is copied to blocks[0] + 0 and all of its children are directly after it,
-     * their children after that, etc.
-     * This just leaves the parents of the new root, which are still needed, so copy them over to erased_parents
+     * A handle is the offset of a node from the start of its memory's region, in units of node_alignment,
+     * so 2^32 handles cover 64 GiB of nodes with 16-byte alignment, 256 GiB with 64 and 1 TiB with 256.
+     * Nodes are 8 bytes short of a multiple of 16 half of the time, so 16 is the smallest unit,
+     * 8 would save 4 bytes per node on average but halve what the handles can address.
      *
-     * NOTE: Any tree traversal while this function is working is undefined,
-     * and probably going to lead to a segmentation fault.
+     * Every memory reserves a region of address space aligned to region_alignment and maps its blocks into it,
+     * an edge finds the region (and the handle unit in its header) from its own address,
+     * so handles resolve without a table and instances never see each other's nodes.
+     * The region header takes the place of a block, so no node is ever at the special handles.
+     */
+    static constexpr uint32_t null_handle = 0, terminal_handle = 1;
+    static constexpr size_t region_alignment = size_t(1) << 40;
+
+    struct region_header
+    {
+        uint32_t handle_shift;  // log2 of node_alignment
+    };
+
+    // referrer is the edge holding the handle, it has to be in the same region
+    static inline mcts::node* from_handle(const void* referrer, uint32_t handle)
+    {
+        auto region = (std::byte*)((uintptr_t)referrer & ~(region_alignment - 1));
+        return (mcts::node*)(region + (size_t(handle) << ((region_header*)region)->handle_shift));
+    }
+
+    static inline uint32_t to_handle(const mcts::node* node)
+    {
+        auto region = (std::byte*)((uintptr_t)node & ~(region_alignment - 1));
+        return uint32_t(((std::byte*)node - region) >> ((region_header*)region)->handle_shift);
+    }
+
+    //endregion
+
+    /*
+     * Starts a compaction, the new root is copied to a free block right away and returned,
+     * everything below it is moved by compaction_step.
+     * The parents of the new root are still needed, so they're copied over to erased_parents.
      *
+     * Starting a compaction while another one is unfinished restarts it from the new root,
+     * the unfinished one's destination blocks simply become from-space as well.
+     *
+     * NOTE: The tree must not be traversed while this function is working.
      */
-    mcts::node* free_unused(mcts::node *new_root, std::vector<std::unique_ptr<mcts::node>> &erased_parents);
+    mcts::node* begin_compaction(mcts::node *new_root, std::vector<std::unique_ptr<mcts::node>> &erased_parents);
 
     /*
-     * Resets all indexes.
-     * The next allocation will return blocks[0] + 0
+     * Moves pending subtrees out of from-space with n_threads threads until there are none left,
+     * or until the deadline passes.
+     *
+     * The tree is consistent after every step, so the search can run in between,
+     * but it must not be traversed while a step is working.
+     *
+     * Returns true if the compaction has finished.
+     */
+    bool compaction_step(std::chrono::high_resolution_clock::time_point deadline, size_t n_threads);
+
+    inline bool is_compacting() const
+    {
+        return !from_space_blocks.empty();
+    }
+
+    inline bool has_budget() const
+    {
+        return max_blocks != 0;
+    }
+
+    /*
+     * Live byte accounting for reclaim_blocks, used by the pruner.
+     *
+     * begin_liveness moves the parents of root out of the arena (same as begin_compaction) and excludes
+     * every block that receives allocations from now on, count_live must then be called once
+     * for every node that is still reachable from root, including root.
+     */
+    void begin_liveness(mcts::node* root, std::vector<std::unique_ptr<mcts::node>>& erased_parents);
+    void count_live(const mcts::node* node);
+
+    /*
+     * Frees every counted block without live nodes, then starts a compaction of the sparsest blocks
+     * as long as there's room to move their nodes to. Unlike begin_compaction, this works with the arena
+     * almost full. root itself is never moved.
+     */
+    void reclaim_blocks(const mcts::node* root);
+
+    /*
+     * Resets all indexes and drops any unfinished compaction.
      * Does not actually free any memory to the system.
      */
     void clear();
 
     /*
-     *  mallocs a new block of memory
+     *  Maps (or mallocs if huge pages are disabled or unsupported) a new block of memory,
+     *  its pages are placed on numa_node with local placement and interleaved with interleaved placement.
      *
-     *  Returns true if a block was successfully allocated, false otherwise.
+     *  Returns true if a block was successfully allocated, false otherwise,
+     *  including when the block would exceed the memory budget.
      */
-    bool sys_malloc_new_block();
+    bool sys_malloc_new_block(int numa_node = 0);
+
+    /*
+     * Limits the memory used for nodes to budget bytes (rounded down to whole blocks, at least 2), 0 for no limit.
+     * Blocks that are already allocated are kept even if they exceed a lowered budget.
+     */
+    void set_budget(size_t budget);
+
+    // Bytes in blocks holding nodes, including from-space of an unfinished compaction
+    size_t used_bytes() const;
+
+    // Bytes that can still be handed out, free blocks plus blocks the budget allows to allocate
+    size_t available_bytes() const;
+
+    // Per mille of the budget (or of the allocated memory without a budget) that holds nodes, as in UCI hashfull
+    int hashfull() const;
+
+    /*
+     * True if fewer than budget_reserve bytes are left, the search should stop creating nodes
+     */
+    bool near_budget() const;
+
+    /*
+     * Set when an allocation fails, until memory is cleared or a compaction frees space
+     */
+    inline bool is_exhausted() const
+    {
+        return exhausted;
+    }
+
+    /*
+     * Prints how many blocks are allocated and how many of them are backed by huge pages.
+     */
+    void report_pages() const;
 
     /*
      * Releases all allocated memory back to the system
@@ -78,22 +243,51 @@ struct memory {
 
 
     /*
-     * Allocates the memory for one node and all of its edges.
+     * Allocates the memory for one node and all of its edges from the calling thread's chunk.
+     * Returns nullptr if the memory budget is exhausted or the system is out of memory.
      */
     mcts::node* allocate_fused_node(size_t edge_count);
 
 
+    //region Leaf recycling
+
+    /*
+     * Leaves are allocated bare and copied once they get their edges (see mcts::node::materialize),
+     * the header left behind is handed out again by allocate_leaf on the thread that retired it.
+     *
+     * Traversals may still be waiting on a retired header for its evaluated flag, or have just read its handle,
+     * so a header retired in recycling epoch e is only reused once every traversal thread has been quiescent
+     * (all of its traversals suspended and the evaluated ones woken) in epoch e or later.
+     * Threads between begin_traversals and end_traversals count, idle ones hold no nodes and don't hold reuse up.
+     *
+     * Only headers in blocks that took allocations in the current liveness epoch are recycled,
+     * so nothing new ends up in a block that reclaim_blocks or a compaction is about to free.
+     */
+    void set_traversal_threads(size_t n_threads);
+    void begin_traversals(size_t thread_index);
+    void end_traversals(size_t thread_index);
+
+    // Called with network_manager::node_processed_lock held, after the thread's evaluated traversals were woken
+    void traversals_quiescent(size_t thread_index);
+
+    // The leaf has no edges and its evaluated flag is already set, under network_manager::node_processed_lock
+    void retire_leaf(mcts::node* leaf);
+
+    // A retired leaf header once it's safe to reuse, otherwise a new allocation (nullptr if out of memory)
+    mcts::node* allocate_leaf();
+
+    //endregion
+
 
-    inline const mcts::node* get_root()
-    {
-        return (mcts::node*)blocks[0];
-    }
 
     /*
-     * Returns a transposition if one is stored and evaluated and the repetitions are the same
-     * The node it returns is locked, when the necessary data is retrieved, it should be unlocked
+     * Returns a transposition of node if one is stored and evaluated and the repetitions are the same,
+     * board is node's position. Leaves have no edges yet, so the moves of board are generated
+     * to rule out hash collisions, but only when there is a candidate.
+     * A candidate that kept only some of its moves matches if they're all legal in board and the remainder
+     * stands for the rest.
      */
-    mcts::node* transposition_check(mcts::node* node);
+    mcts::node* transposition_check(mcts::node* node, chess::board const& board);
 
 
     // Returns a batch to be used for NN input planes
@@ -107,15 +301,165 @@ private:
     std::vector<float*> batch_intermediate_memory;
     std::mutex batch_intermediate_memory_lock;
 
-    const int get_parent_block_index(const mcts::node* node);
-    mcts::node* allocate_fused_node_lockless(size_t edge_count);
+    enum block_state : uint8_t
+    {
+        free_block,
+        used_block,
+        from_space_block
+    };
+
+    // Stored at the start of every block
+    struct block_header
+    {
+        uint32_t index;
+        block_state state;
+        uint32_t liveness_epoch; // Epoch in which the block started taking allocations
+        int32_t numa_node;       // Node the block's pages are placed on, -1 if they aren't
+    };
+
+    inline block_header* get_header(const mcts::node* node) const
+    {
+        return (block_header*)((uintptr_t)node & ~(uintptr_t)(block_size - 1));
+    }
+
+    inline block_header* get_header(size_t block_index) const
+    {
+        return (block_header*)blocks[block_index];
+    }
+
+    inline uint32_t get_parent_block_index(const mcts::node* node) const
+    {
+        return get_header(node)->index;
+    }
+
+    inline bool in_from_space(const mcts::node* node) const
+    {
+        return get_header(node)->state == from_space_block;
+    }
+
+    // Bump allocation position, one per NUMA node with local placement and a single one otherwise
+    struct arena
+    {
+        size_t current_block = 0, index_in_block = 0;
+    };
+
+    /*
+     * Reserves size contiguous bytes in the current block of the calling thread's arena,
+     * moving on to the next block if necessary.
+     * Must hold memory_lock.
+     */
+    std::byte* allocate_from_blocks(size_t size);
+    std::byte* allocate_from_chunk(allocation_chunk& chunk, size_t size);
+
+    /*
+     * Makes a free (or newly allocated) block the current block of an arena, must hold memory_lock.
+     * With local placement, blocks already on the arena's node are preferred, others get their pages moved.
+     * Returns false if out of memory.
+     */
+    bool next_block(size_t arena_index);
+
+    /*
+     * Copies the subtrees on the stack out of from-space depth first, until the stack is empty or the deadline passes.
+     */
+    void relocate_subtrees(std::vector<mcts::node*>& stack, allocation_chunk& chunk,
+                           std::chrono::high_resolution_clock::time_point deadline,
+                           std::vector<std::pair<uint64_t, mcts::node*>>& relocated);
+
+    // Returns from-space to the free blocks
+    void release_from_space();
+
+    // Moves the parents of root into erased_parents, they're needed for history but not part of the tree anymore
+    void erase_parents(mcts::node* root, std::vector<std::unique_ptr<mcts::node>>& erased_parents);
+
+    /*
+     * Entries are only valid for the generation they were written in, every compaction starts a new one.
+     * Clearing a table this size takes far longer than a compaction step is allowed to,
+     * so stale entries are just ignored until clear() or until they're overwritten.
+     */
+    struct transposition_entry
+    {
+        mcts::node* node;
+        uint32_t generation;
+    };
+
+    static constexpr size_t max_transpositions = 1 << 24;
 
     std::mutex transposition_table_lock;
-    std::unordered_map<uint64_t, mcts::node*> transposition_table;
+    std::unordered_map<uint64_t, transposition_entry> transposition_table;
+    uint32_t transposition_generation = 0;
+
+    enum block_backing : uint8_t
+    {
+        plain_backed,       // Anonymous mapping with regular pages, huge pages disabled or unavailable
+        thp_backed,         // Anonymous mapping advised with MADV_HUGEPAGE, huge pages up to the kernel
+        hugetlb_backed      // Explicit huge pages from the reserved pool
+    };
+
+    // Maps a block at its address in the region, returns false if the system is out of memory
+    bool sys_map_block(std::byte* memory, block_backing& backing);
+
+    // Blocks are mapped at fixed addresses in the region, block i right after the region header at block i + 1
+    std::byte* region = nullptr;
+    size_t region_size = 0;
+
+    // Blocks that fit in the region with every node addressable by a handle
+    size_t max_region_blocks() const;
+
+    numa::placement placement;
+    std::vector<arena> arenas;
+
+    size_t block_size, max_nn_batch_size, chunk_size, node_alignment;
+
+    inline size_t align_node_size(size_t size) const
+    {
+        return (size + node_alignment - 1) & ~(node_alignment - 1);
+    }
+    bool huge_pages;
+
+    // Incremented by clear(), begin_compaction() and begin_liveness(), invalidates every thread's chunk and retired leaves
+    std::atomic<uint32_t> chunk_generation;
+
+    // Syncs the calling thread's recycler with this memory and the current generation, drops its leaves if either changed
+    leaf_recycler& local_recycler();
+
+    struct alignas(64) recycling_slot
+    {
+        std::atomic<uint64_t> epoch;
+    };
+
+    static constexpr uint64_t idle_epoch = UINT64_MAX;
+
+    // Incremented by every retired leaf
+    std::atomic<uint64_t> recycling_epoch = 0;
+
+    // The last recycling epoch each traversal thread was quiescent in, idle_epoch if it isn't traversing
+    std::unique_ptr<recycling_slot[]> recycling_slots;
+    size_t n_recycling_slots = 0;
+
+    // 0 if unlimited
+    size_t max_blocks = 0;
+    std::atomic<bool> exhausted = false;
+
+    std::vector<uint32_t> free_blocks, used_blocks, from_space_blocks;
+
+    /*
+     * Nodes in from-space whose subtrees still have to be moved, their parents are already moved.
+     * A selective compaction (reclaim_blocks) only has some blocks in from-space, so it walks the whole tree instead.
+     */
+    std::vector<mcts::node*> compaction_queue;
+    bool selective_compaction = false;
+
+    uint32_t liveness_epoch = 0;
+    std::vector<size_t> live_bytes;
+    std::vector<std::vector<mcts::node*>> compaction_stacks;
+    std::vector<std::vector<std::pair<uint64_t, mcts::node*>>> compaction_relocated;
+    std::vector<allocation_chunk> compaction_chunks;
 
-    size_t current_block, index_in_block, block_size, max_nn_batch_size;
+    size_t compaction_moved_nodes = 0, compaction_steps = 0;
+    std::chrono::high_resolution_clock::duration compaction_time{};
     std::vector<std::byte*> blocks;
-    std::mutex memory_lock;
+    std::vector<block_backing> block_backings;
+    mutable std::mutex memory_lock;
 };
 
 #endif //FIREFLY_MEMORY_H
@@ -23,6 +23,7 @@
 #include <random>
 #include <mutex>
 #include <utils/utils.h>
+#include <chess/batch_movegen.h>
 
 using namespace std;
 using namespace mcts;
@@ -35,39 +36,37 @@ thread_local uint8_t mcts::node::thread_id;
 std::string edge::print() const
 {
     stringstream ss;
-    if (!terminal)
-        ss << "Node move: " << move.to_uci_move() << "  Terminal: false   Prior: " << P_ << "   Node ptr: " << node_;
+    if (!is_terminal())
+        ss << "Node move: " << move.to_uci_move() << "  Terminal: false   Prior: " << float(P_) << "   Node ptr: " << get_node();
     else
-        ss << "Node move: " << move.to_uci_move() << "  Terminal: true   Value: " << terminal_value;
+        ss << "Node move: " << move.to_uci_move() << "  Terminal: true   Value: " << float(terminal_value);
 
     return ss.str();
 }
 
-mcts::edge::edge(const chess::move &move) : move(move), node_(nullptr), P_(0), terminal(false){}
+mcts::edge::edge(const chess::move &move) :
+    node_handle(memory::null_handle),
+    P_(0),
+    move(move)
+{}
 
-bool mcts::edge::expand(mcts::node* parent, memory& memory_)
+bool mcts::edge::expand(mcts::node* parent, memory& memory_, path_history const& path)
 {
     // Just in case two threads reach the same leaf at the same time.
 
     std::lock_guard lock(*parent);
 
-    if (node_ != nullptr)
+    if (get_node() != nullptr)
     {
-
         // Decrement pending visits, as this visit will be aborted.
-        auto node = parent;
-        while (node && node != current_root)
-        {
-            node->visits_pending--;
-            node = node->parent;
-        }
-
+        parent->cancel_pending_visits();
         return false;
     }
 
     // Set node_ to a temporary value, simply to prevent any other threads from trying to expand it
 
-    auto board = parent->board;
+    // path ends with the parent's position
+    auto board = path.top();
     board.make_move(move);
 
     bool reversible_move = true;
@@ -85,19 +84,11 @@ bool mcts::edge::expand(mcts::node* parent, memory& memory_)
     else [[likely]]
     {
         // Check for threefold repetition.
-        auto node = parent;
+        repetitions = path.repetitions(board);
 
-        while (node && node->reversible_move)
-        {
-            if (board.tfr_compare(node->board)) {
-                repetitions = node->repetitions + 1;
-                if (repetitions == 3) {
-                    //set_terminal(chess::game_state::draw, parent);
-                    //return false;
-                }
-                break;
-            }
-            node = node->parent;
+        if (repetitions == 3) {
+            //set_terminal(chess::game_state::draw, parent);
+            //return false;
         }
 
         reversible_move = true;
@@ -105,34 +96,41 @@ bool mcts::edge::expand(mcts::node* parent, memory& memory_)
 
     board.has_repeated = repetitions != 0;
 
-    chess::movegen_result moves;
-    auto gstate = board.generate_moves(moves);
+    auto memory = memory_.allocate_leaf();
 
-    if (gstate != chess::game_state::playing)
+    // Out of node memory, abort the visit the same way as above
+    if (memory == nullptr) [[unlikely]]
     {
-        set_terminal(gstate, parent);
+        parent->cancel_pending_visits();
         return false;
     }
 
-    node_ = new (memory_.allocate_fused_node(moves.moves_count))
-            mcts::node(board, moves, parent, reversible_move, repetitions);
+    auto node = new (memory) mcts::node(board, parent, reversible_move, repetitions);
 
-    node_->index_in_parent = this - parent->get_edges();
+    node->index_in_parent = this - parent->get_edges();
+    set_node(node);
 
     return true;
 }
 
 void mcts::edge::set_terminal(chess::game_state state, node *parent) {
     terminal_value = state == chess::game_state::checkmate ? 1 : 0;
-    terminal = true;
-    node_ = nullptr;
+    node_handle = memory::terminal_handle;
     //parent->update_value(-terminal_value);
     parent->update_value_for_terminal_child(state, this - parent->begin());
 }
 
 float mcts::edge::get_value() const {
     // If the node is not expanded, assume it's losing
-    return is_expanded() ? (is_terminal() ? terminal_value : this->node_->average_value()) : -1;
+    return is_expanded() ? (is_terminal() ? float(terminal_value) : get_node()->average_value()) : -1;
+}
+
+mcts::edge* mcts::node::best_edge_by_value()
+{
+    return std::max_element(begin(), end(), [](auto& a, auto& b)
+    {
+        return a.get_value() < b.get_value();
+    });
 }
 //endregion
 
@@ -143,24 +141,35 @@ mcts::node::node(const chess::board &board,
                  node* parent,
                  bool reversible_move,
                  uint8_t repetitions) :
-    board(board),
-    visit_count(0),
+    node(board, parent, reversible_move, repetitions)
+{
+    edge_count = moves.moves_count;
+    viable_edges = moves.moves_count;
+
+    auto edges = get_edges();
+    for (int i = 0; i < edge_count; i++)
+        new (edges + i) mcts::edge(moves.moves[i]);
+}
+
+mcts::node::node(const chess::board &board,
+                 node* parent,
+                 bool reversible_move,
+                 uint8_t repetitions) :
     Q_(0),
-    parent(parent),
-    edge_count(moves.moves_count),
-    viable_edges(moves.moves_count),
+    visit_count(0),
     visits_pending(1),
-    reversible_move(reversible_move),
+    locking_tid(thread_id),
+    lock_count(1),
+    parent(parent),
+    position_hash(board.hash()),
+    edge_count(0),
+    viable_edges(0),
     repetitions(repetitions),
+    reversible_move(reversible_move),
     evaluated(false),
     solution(unsolved),
-    locking_tid(thread_id),
-    lock_count(1)
+    flipped(board.flipped)
 {
-    auto edges = get_edges();
-    for (int i = 0; i < edge_count; i++)
-        new (edges + i) mcts::edge(moves.moves[i]);
-
     /*
      * The board is now seen from the player to move's perspective, however the
      * node's value is from the perspective of the player who just moved to get to this state,
@@ -188,6 +197,272 @@ mcts::node::node(const chess::board &board,
 //endregion
 
 
+//region Materialization
+
+namespace
+{
+    // Copies the leaf's header to an allocation with room for n_edges edges, the edges are up to the caller
+    mcts::node* copy_with_room_for_edges(mcts::node* leaf, memory& memory_, size_t n_edges)
+    {
+        auto copy = memory_.allocate_fused_node(n_edges);
+
+        if (copy == nullptr) [[unlikely]]
+        {
+            leaf->roll_back();
+            return nullptr;
+        }
+
+        memcpy((void*)copy, leaf, sizeof(mcts::node));
+        copy->edge_count = n_edges;
+        copy->viable_edges = n_edges;
+
+        return copy;
+    }
+
+    // Readers of the edge hold the parent's lock
+    void publish(mcts::node* copy)
+    {
+        if (!copy->has_own_edge())
+            return;
+
+        std::lock_guard lock(*copy->parent);
+        copy->get_own_edge()->set_node(copy);
+    }
+}
+
+mcts::node* mcts::node::materialize(memory& memory_, const chess::move* moves, size_t n_moves,
+                                    const float* priors, edge_limit limit)
+{
+    if (!priors)
+    {
+        auto copy = copy_with_room_for_edges(this, memory_, n_moves);
+        if (!copy) return nullptr;
+
+        auto edges = copy->get_edges();
+        for (size_t i = 0; i < n_moves; i++)
+            new (edges + i) mcts::edge(moves[i]);
+
+        publish(copy);
+        return copy;
+    }
+
+    // Move indices by descending prior, only as many as can be kept have to be in order
+    uint8_t order[256];
+    for (size_t i = 0; i < n_moves; i++)
+        order[i] = i;
+
+    size_t n_sorted = limit.max_edges ? std::min(limit.max_edges, n_moves) : n_moves;
+    std::partial_sort(order, order + n_sorted, order + n_moves, [priors](uint8_t a, uint8_t b) {
+        return priors[a] > priors[b];
+    });
+
+    size_t n_kept = 0;
+    float kept_mass = 0;
+
+    while (n_kept < n_sorted && (limit.prior_mass >= 1 || kept_mass < limit.prior_mass))
+        kept_mass += priors[order[n_kept++]];
+
+    // A remainder only pays off for at least two moves
+    if (n_moves - n_kept < 2)
+    {
+        if (n_sorted != n_moves)
+            std::sort(order + n_sorted, order + n_moves, [priors](uint8_t a, uint8_t b) {
+                return priors[a] > priors[b];
+            });
+
+        n_kept = n_moves;
+    }
+
+    auto copy = copy_with_room_for_edges(this, memory_, n_kept + (n_kept != n_moves));
+    if (!copy) return nullptr;
+
+    auto edges = copy->get_edges();
+
+    for (size_t i = 0; i < n_kept; i++)
+    {
+        new (edges + i) mcts::edge(moves[order[i]]);
+        edges[i].set_prior(priors[order[i]]);
+    }
+
+    if (n_kept != n_moves)
+    {
+        float remainder_mass = 0;
+        for (size_t i = n_kept; i < n_moves; i++)
+            remainder_mass += priors[order[i]];
+
+        new (edges + n_kept) mcts::edge(chess::move(0, 0));
+        edges[n_kept].set_prior(remainder_mass);
+    }
+
+    publish(copy);
+    return copy;
+}
+
+void mcts::node::roll_back()
+{
+    std::lock_guard lock(*parent);
+    get_own_edge()->set_node(nullptr);
+    parent->cancel_pending_visits();
+}
+
+mcts::node* mcts::node::materialize(memory& memory_, const node* transposition)
+{
+    auto copy = copy_with_room_for_edges(this, memory_, transposition->edge_count);
+    if (!copy) return nullptr;
+
+    memcpy((void*)copy->get_edges(), transposition + 1, transposition->edge_count * sizeof(mcts::edge));
+
+    publish(copy);
+    return copy;
+}
+
+mcts::node* mcts::node::complete_edges(memory& memory_, chess::board const& board, float prior_mass)
+{
+    chess::movegen_result moves;
+    board.generate_moves(moves);
+
+    auto copy = memory_.allocate_fused_node(moves.moves_count);
+    if (!copy) return nullptr;
+
+    memcpy((void*)copy, this, sizeof(mcts::node));
+
+    // The edges that were kept stay in front, in the same order
+    auto edges = copy->get_edges();
+    size_t n = 0;
+
+    for (auto& i : *this)
+        if (!i.is_remainder())
+            edges[n++] = i;
+
+    size_t n_kept = n;
+
+    for (size_t i = 0; i < moves.moves_count; i++)
+    {
+        bool kept = false;
+        for (size_t j = 0; j < n_kept && !kept; j++)
+            kept = edges[j].move == moves.moves[i];
+
+        if (!kept)
+            new (edges + n++) mcts::edge(moves.moves[i]);
+    }
+
+    for (size_t i = n_kept; i < n; i++)
+        edges[i].set_prior(prior_mass / (n - n_kept));
+
+    copy->edge_count = n;
+    copy->viable_edges = viable_edges - 1 + (n - n_kept);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if (auto child = edges[i].get_node())
+        {
+            child->parent = copy;
+            child->index_in_parent = i;
+        }
+    }
+
+    if (has_own_edge())
+        get_own_edge()->set_node(copy);
+
+    return copy;
+}
+
+void mcts::node::make_terminal(chess::game_state state)
+{
+    std::lock_guard lock(*parent);
+    get_own_edge()->set_terminal(state, parent);
+}
+
+void mcts::generate_leaf_moves(std::vector<batch_entry> const& batch, batch_moves& out)
+{
+    // Constructing a movegen_result isn't free (1024 moves), so every thread keeps its own
+    thread_local chess::movegen_result moves[chess::batch_movegen_lanes];
+
+    const chess::board* boards[chess::batch_movegen_lanes];
+    chess::game_state states[chess::batch_movegen_lanes];
+    size_t leaves[chess::batch_movegen_lanes];
+
+    size_t n = 0;
+
+    out.moves.clear();
+    out.first.assign(batch.size() + 1, 0);
+    out.needs_network.resize(batch.size());
+
+    // Moves are appended in batch order, entries without moves just repeat the previous end
+    size_t next_entry = 0;
+
+    auto close_entries_until = [&](size_t i)
+    {
+        for (; next_entry < i; next_entry++)
+            out.first[next_entry + 1] = out.moves.size();
+    };
+
+    auto flush = [&]()
+    {
+        chess::generate_moves_batch(boards, moves, states, n);
+
+        for (size_t j = 0; j < n; j++)
+        {
+            auto i = leaves[j];
+            close_entries_until(i);
+
+            if (states[j] != chess::game_state::playing)
+            {
+                batch[i].node->make_terminal(states[j]);
+                out.needs_network[i] = false;
+            }
+            else
+                out.moves.insert(out.moves.end(), moves[j].moves, moves[j].moves + moves[j].moves_count);
+
+            close_entries_until(i + 1);
+        }
+
+        n = 0;
+    };
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        auto& entry = batch[i];
+        out.needs_network[i] = !entry.node->evaluated;
+
+        if (entry.node->has_edges() || entry.node->evaluated)
+            continue;
+
+        // The leaf's own position is the last one of its history
+        boards[n] = &entry.history[entry.history_size - 1];
+        leaves[n++] = i;
+
+        if (n == chess::batch_movegen_lanes)
+            flush();
+    }
+
+    if (n != 0)
+        flush();
+
+    close_entries_until(batch.size());
+}
+
+void mcts::materialize_leaves(std::vector<batch_entry> const& batch, memory& memory_, node** nodes)
+{
+    thread_local batch_moves moves;
+    generate_leaf_moves(batch, moves);
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        auto node = batch[i].node;
+
+        if (!moves.needs_network[i])
+            nodes[i] = nullptr;
+        else if (node->has_edges())
+            nodes[i] = node;
+        else
+            nodes[i] = node->materialize(memory_, moves.begin(i), moves.count(i));
+    }
+}
+
+//endregion
+
+
 
 void mcts::node::update_value(float value)
 {
@@ -196,7 +471,8 @@ void mcts::node::update_value(float value)
         throw std::logic_error("Node value out of bounds.");
 #endif
     lock();
-    Q_ = (Q_ * visit_count + value) / ++visit_count;
+    Q_ = (Q_ * visit_count + value) / (visit_count + 1);
+    visit_count++;
 
     visits_pending--;
     unlock();
@@ -21,9 +21,12 @@
 
 #include <chess/board.h>
 #include <atomic>
+#include <cstddef>
 #include <vector>
 #include <mutex>
 #include "memory.h"
+#include "path_history.h"
+#include <utils/parking.h>
 
 
 extern mcts::node* current_root;
@@ -77,6 +80,8 @@ namespace mcts {
     };
     struct node;
 
+    inline parking::site node_lock_site("node locks");
+
 
     /*
      * On solving branches:
@@ -87,24 +92,27 @@ namespace mcts {
     struct edge
     {
         /*
-         * If not expanded, then node == nullptr
+         * Handle of the child node (see memory::from_handle), memory::null_handle if not expanded
+         * and memory::terminal_handle if the move ends the game.
          */
-        node* node_;
-
+        uint32_t node_handle;
 
+        /*
+         * Half precision is plenty for priors, selection only ever compares them after scaling.
+         * The terminal value is either 0 or 1.
+         */
         union {
-            float P_;
-            float terminal_value;
+            _Float16 P_;
+            _Float16 terminal_value;
         };
 
         chess::move move;
-        bool terminal;
 
 
         std::string print() const;
 
 
-        explicit edge(chess::move const& move);
+        edge(chess::move const& move);
         void set_prior(float new_p)
         {
             P_ = new_p;
@@ -114,35 +122,80 @@ namespace mcts {
         /*
          * 1. Copy parent board.
          * 2. Apply move to board
-         * 2a. Check for fifty move rule or threefold repetition
-         * 3. Generate moves.
-         * 3a. Check for checkmate or stalemate.
-         * 4. Allocate node and edges
+         * 2a. Check for fifty move rule or threefold repetition, path must hold the history up to and including parent
+         * 3. Allocate a leaf node without edges
          *
          * If the state after 2. ends up being terminal for any reason,
          * the edge doesn't allocate a node, instead it just stores the
          * state's value in terminal_value
+         *
+         * Moves aren't generated here, under the parent's lock, checkmate and stalemate are only found
+         * once the leaf gets its edges, see node::materialize.
          */
-        bool expand(mcts::node* parent, memory& memory_);
+        bool expand(mcts::node* parent, memory& memory_, path_history const& path);
 
         inline bool is_expanded() const
         {
-            return node_ != nullptr || terminal;
+            return node_handle != memory::null_handle;
         }
         inline bool is_terminal() const
         {
-            return terminal;
+            return node_handle == memory::terminal_handle;
+        }
+
+        /*
+         * Stands in for the moves that were dropped when the node's edges were limited (see edge_limit),
+         * P_ is their total prior. Its move is the only one with the same source and destination square.
+         */
+        inline bool is_remainder() const
+        {
+            return move.src == move.dst;
         }
         void set_terminal(chess::game_state state, mcts::node* parent);
 
-        inline mcts::node* get_node()
+        inline mcts::node* get_node() const
         {
-            return node_;
+            return node_handle > memory::terminal_handle ? memory::from_handle(this, node_handle) : nullptr;
+        }
+
+        // nullptr makes the edge unexpanded again
+        inline void set_node(const mcts::node* node)
+        {
+            node_handle = node ? memory::to_handle(node) : memory::null_handle;
+        }
+
+        /*
+         * Index of the move in the flattened policy head output, flipped if the parent is black to move.
+         * A table lookup, so it isn't stored.
+         */
+        inline uint16_t policy_index(bool flipped) const
+        {
+            return flipped ? move.to_flipped_policy_index() : move.to_policy_index();
         }
 
         float get_value() const;
     };
 
+    static_assert(sizeof(edge) == 8, "Edges are stored in bulk after their parent node");
+
+
+    /*
+     * How many edges a node keeps once its priors are known, the edges with the highest priors are kept
+     * until there are max_edges of them or they hold prior_mass of the policy, whichever comes first.
+     * The rest are folded into a single remainder edge, the node gets all of its edges back
+     * if the search selects the remainder (see node::complete_edges).
+     */
+    struct edge_limit
+    {
+        size_t max_edges = 0; // 0 for no limit
+        float prior_mass = 1;
+
+        inline bool is_limited() const
+        {
+            return max_edges != 0 || prior_mass < 1;
+        }
+    };
+
 
     struct prior_iterator : public std::iterator_traits<mcts::edge*>
     {
@@ -152,7 +205,7 @@ namespace mcts {
             ptr = edge;
         }
 
-        inline float& operator*() const
+        inline float operator*() const
         {
             return ptr->P_;
         }
@@ -189,7 +242,6 @@ namespace mcts {
     class node
     {
         edge* tablebase_move();
-        edge* best_edge_by_value();
 
         friend class mcts::edge;
         inline void update_value_for_terminal_child(chess::game_state state, int child_idx)
@@ -199,16 +251,14 @@ namespace mcts {
             adjust_value_for_solved_branch<true>(0, state == chess::game_state::checkmate ? winning : drawn, 0, child_idx);
         }
     public:
-        // 8 bytes
-        node *parent;
-
-        //region Data
-        //34 bytes
-        chess::board board;
-
-        vector<mcts::node*>* batch_pointer = nullptr;
-
 
+        /*
+         * Hot region, written by every visit (selection, backpropagation and the node lock).
+         * It comes first so it sits at the start of the node's first cache line, nodes start at memory's
+         * node alignment (a cache line by default), so one node's statistics never share a line with
+         * another node's read-mostly fields or edges.
+         */
+        //region Statistics
 
         // 4 bytes
         floatx Q_;
@@ -217,8 +267,27 @@ namespace mcts {
         uint32_t visit_count;
         copyable_atomic<uint32_t> visits_pending;
 
-
         // 2 bytes
+        copyable_atomic<uint8_t> locking_tid;
+        uint8_t lock_count;
+
+        //endregion
+
+        // Everything below is written at most a few times over the node's lifetime
+
+        // 8 bytes
+        node *parent;
+
+        //region Data
+
+        /*
+         * 8 bytes
+         * The node doesn't store its board, it's rebuilt from the root by the traversal thread (see path_history).
+         * The hash of the board is kept for the transposition table.
+         */
+        uint64_t position_hash;
+
+        // 4 bytes
         uint8_t edge_count; // Hope it never needs more than 256 edges
         uint8_t index_in_parent;
 
@@ -235,6 +304,9 @@ namespace mcts {
 
         uint8_t moves_left; // moves_left == min(moves_left, 255)
 
+        // 2 bytes, low bits of the search's shared batch generation the node was added to
+        uint16_t batch_generation;
+
 #ifdef DEBUG_CHECKS // Used to identify nodes created by transposition for debugging purposes
         bool transposition = false;
 #endif
@@ -243,13 +315,12 @@ namespace mcts {
         bool reversible_move: 1;
         bool evaluated:1;
         solution_state solution : 2;
+        bool flipped:1; // Black to move, the policy is seen from the player to move
         //endregion
 
         //endregion
 
         static thread_local uint8_t thread_id;
-        copyable_atomic<uint8_t> locking_tid;
-        uint8_t lock_count;
 
         inline void lock()
         {
@@ -257,11 +328,12 @@ namespace mcts {
                 lock_count++;
                 return;
             }
-            uint8_t f = -1;
-            while (!locking_tid.compare_exchange_weak(f, thread_id)) {
-                f = -1;
-                std::this_thread::yield();
-            }
+
+            // Strong, a spurious failure right before parking would wait for a change that never comes
+            parking::wait_until(locking_tid, [this]() {
+                uint8_t f = -1;
+                return locking_tid.compare_exchange_strong(f, thread_id);
+            }, node_lock_site);
 
             lock_count = 1;
         }
@@ -297,7 +369,10 @@ namespace mcts {
                 throw std::logic_error("Unlocking non-locked node.");
 #endif
             if (--lock_count == 0)
+            {
                 locking_tid = -1;
+                parking::notify(locking_tid, node_lock_site);
+            }
         }
 
         /*
@@ -313,8 +388,21 @@ namespace mcts {
         inline mcts::edge* get_own_edge() { return (mcts::edge*)(parent + 1) + index_in_parent; }
         inline const mcts::edge* get_own_edge() const { return (mcts::edge*)(parent + 1) + index_in_parent; }
 
+        // False for a root whose parent was erased, the copy kept for history has no edges (see memory::erase_parents)
+        inline bool has_own_edge() const { return parent && index_in_parent < parent->edge_count; }
+
         inline bool is_solved() const { return solution != solution_state::unsolved; }
 
+        // Leaves get their edges when they're evaluated, a node that has been to the network always has edges
+        inline bool has_edges() const { return edge_count != 0; }
+
+        // Takes back the pending visits of a selection that ended below this node without a visit (see puct_select)
+        inline void cancel_pending_visits()
+        {
+            for (auto node = this; node && node != current_root; node = node->parent)
+                node->visits_pending--;
+        }
+
         inline prior_iterator priors_begin() { return prior_iterator(get_edges()); }
         inline prior_iterator priors_end() { return priors_begin() + edge_count; }
 
@@ -326,6 +414,12 @@ namespace mcts {
         inline float average_value() const { return Q_; }
 
 
+        /*
+         * The edge with the highest value, the first one of equal ones.
+         * Doesn't reorder the edges: children waiting to be moved by a compaction find their own edge by index_in_parent.
+         */
+        edge* best_edge_by_value();
+
         inline edge* best_move()
         {
             switch(solution)
@@ -551,6 +645,52 @@ namespace mcts {
              bool reversible_move=false,
              uint8_t repetitions=0);
 
+        // Leaf without edges
+        node(const chess::board &board,
+             node *parent,
+             bool reversible_move,
+             uint8_t repetitions);
+
+
+        /*
+         * Gives a leaf its edges, either the legal moves of its position or copies of a transposition's edges.
+         *
+         * Edges are stored right after their node, so the leaf is copied to a new allocation with room for them
+         * and its parent's edge is pointed at the copy, which is returned. The old copy stays where it is
+         * for threads that are waiting on it (re-read the edge after waiting) and is freed by the next compaction.
+         *
+         * With priors (one per move), the edges come out sorted by prior and limited to limit.
+         *
+         * Returns nullptr if there's no memory left, the edge is unexpanded again and the visit is cancelled.
+         */
+        node* materialize(memory& memory_, const chess::move* moves, size_t n_moves,
+                          const float* priors = nullptr, edge_limit limit = {});
+        node* materialize(memory& memory_, node const* transposition);
+
+        // An unevaluated leaf is dropped, its edge is unexpanded again and the pending visits of its path are taken back
+        void roll_back();
+
+        inline bool has_remainder() const
+        {
+            for (auto it = (const edge*)(this + 1), end = it + edge_count; it != end; it++)
+                if (it->is_remainder()) return true;
+
+            return false;
+        }
+
+        /*
+         * Replaces the remainder edge with the moves it stood for, the remainder's prior (passed in prior_mass,
+         * the edge's own may have been zeroed since) is split evenly between them as their own priors are gone.
+         * board is the node's position.
+         *
+         * Works like materialize, except the node has children, so the tree must not be traversed meanwhile.
+         * Returns nullptr if there's no memory left, the node is left as it is.
+         */
+        node* complete_edges(memory& memory_, chess::board const& board, float prior_mass);
+
+        // The leaf's position turned out to be checkmate or stalemate, its edge becomes terminal instead
+        void make_terminal(chess::game_state state);
+
 
         void generate_children();
 
@@ -563,7 +703,7 @@ namespace mcts {
         inline void copy_to(void* memory)
         {
             memcpy(memory, this, get_total_size());
-            get_own_edge()->node_ = static_cast<mcts::node *>(memory);
+            get_own_edge()->set_node(static_cast<mcts::node *>(memory));
             for (auto& i : *this)
             {
                 if (i.get_node())
@@ -576,5 +716,39 @@ namespace mcts {
 
     };
 
+#ifndef DEBUG_CHECKS
+    static_assert(sizeof(node) == 40, "Nodes are the bulk of the tree, keep them small");
+    static_assert(offsetof(node, lock_count) < 16, "The statistics have to stay at the start of the node");
+#endif
+
+
+    /*
+     * Legal moves of the leaves in a batch, the moves of batch[i] are moves[first[i]] up to moves[first[i + 1]].
+     */
+    struct batch_moves
+    {
+        std::vector<chess::move> moves;
+        std::vector<uint32_t> first;
+
+        // False for leaves that turned out to be terminal and for entries that are already evaluated
+        std::vector<uint8_t> needs_network;
+
+        inline const chess::move* begin(size_t i) const { return moves.data() + first[i]; }
+        inline size_t count(size_t i) const { return first[i + 1] - first[i]; }
+    };
+
+    /*
+     * Generates the moves of every leaf in a batch at once (chess::generate_moves_batch).
+     * Leaves whose positions are checkmate or stalemate become terminal edges.
+     * Entries that already have edges get no moves.
+     */
+    void generate_leaf_moves(std::vector<batch_entry> const& batch, batch_moves& out);
+
+    /*
+     * Generates the moves of every leaf in a batch and materializes the leaves with all of their edges,
+     * nodes[i] is the node that batch[i] has to be evaluated as.
+     * It's nullptr if the leaf needs no evaluation, its position was terminal or there was no memory for its edges.
+     */
+    void materialize_leaves(std::vector<batch_entry> const& batch, memory& memory_, node** nodes);
 }
 #endif //FIREFLY_MCTS_NODE_H
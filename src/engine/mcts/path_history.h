@@ -0,0 +1,197 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_PATH_HISTORY_H
+#define FIREFLY_PATH_HISTORY_H
+
+#include <chess/board.h>
+#include <vector>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+
+namespace mcts {
+
+    struct node;
+
+    /*
+     * Every position from the last irreversible move of the game (and at least the last 8 for the network)
+     * up to the node a traversal thread is currently at.
+     *
+     * Each traversal thread owns one, it starts out as a copy of the root's history and
+     * gets a position pushed for every node on the way down. Nodes don't store their board,
+     * the boards here are the only copies and get rebuilt by replaying the moves of the path.
+     * Repetition detection during expansion never has to walk parent pointers or compare boards.
+     *
+     * A small counting filter over the keys answers the common "never seen" case with a single lookup,
+     * only keys that pass the filter get compared against the stack.
+     */
+    struct path_history
+    {
+        struct entry
+        {
+            uint64_t key;
+            uint8_t repetitions;
+        };
+
+        path_history()
+        {
+            clear();
+        }
+
+        inline void clear()
+        {
+            entries.clear();
+            boards.clear();
+            memset(filter, 0, sizeof(filter));
+        }
+
+        inline void push(chess::board const& board, uint8_t repetitions)
+        {
+            auto key = board.position_key();
+
+            entries.push_back({key, repetitions});
+            boards.push_back(board);
+            filter[slot(key)]++;
+        }
+
+        // Pushes the position reached by move from the last pushed position
+        inline void push(chess::move move, uint8_t repetitions)
+        {
+            auto board = boards.back();
+            board.make_move(move);
+            board.has_repeated = repetitions != 0;
+
+            push(board, repetitions);
+        }
+
+        inline void pop()
+        {
+            filter[slot(entries.back().key)]--;
+            entries.pop_back();
+            boards.pop_back();
+        }
+
+        // Last pushed position
+        inline chess::board const& top() const
+        {
+            return boards.back();
+        }
+
+        // Copies up to the last n positions into out, oldest first, returns how many were copied
+        inline size_t last_positions(chess::board* out, size_t n) const
+        {
+            n = std::min(n, boards.size());
+            std::copy(boards.end() - n, boards.end(), out);
+            return n;
+        }
+
+        // Pops entries until only the first size remain
+        inline void truncate(size_t size)
+        {
+            while (entries.size() > size)
+                pop();
+        }
+
+        inline void assign(path_history const& other)
+        {
+            entries = other.entries;
+            boards = other.boards;
+            memcpy(filter, other.filter, sizeof(filter));
+        }
+
+        inline size_t size() const
+        {
+            return entries.size();
+        }
+
+        /*
+         * Returns the repetition count of a position reached by a move from the last pushed position,
+         * 0 if the position hasn't occurred before.
+         *
+         * Only positions with the same player to move within the last halfmove_clock plies can repeat.
+         */
+        inline uint8_t repetitions(chess::board const& board) const
+        {
+            auto key = board.position_key();
+
+            if (filter[slot(key)] == 0) [[likely]]
+                return 0;
+
+            size_t plies = std::min<size_t>(board.halfmove_clock, entries.size());
+
+            for (size_t back = 2; back <= plies; back += 2)
+            {
+                auto& e = entries[entries.size() - back];
+                if (e.key == key)
+                    return std::min(e.repetitions + 1, 3);
+            }
+
+            return 0;
+        }
+
+    private:
+        static constexpr int filter_bits = 12;
+
+        static inline size_t slot(uint64_t key)
+        {
+            return key >> (64 - filter_bits);
+        }
+
+        std::vector<entry> entries;
+        std::vector<chess::board> boards;
+        uint16_t filter[1 << filter_bits];
+    };
+
+
+    /*
+     * The order in which the entries of a batch are finished, and the threads waiting on them woken,
+     * see network_manager::blocking_inference.
+     */
+    enum class eval_priority : uint8_t
+    {
+        blocking,   // A traversal is suspended on the node
+        normal,     // Selected by a traversal that went on with something else
+        filler      // Not selected by anyone yet, see search::speculate
+    };
+
+
+    /*
+     * A node waiting for the network together with its position and the ones before it,
+     * since the node itself doesn't know its position.
+     */
+    struct batch_entry
+    {
+        static constexpr size_t max_history = 8;
+
+        mcts::node* node;
+        uint8_t history_size;
+        eval_priority priority = eval_priority::normal;
+        std::chrono::steady_clock::time_point queued;
+        chess::board history[max_history]; // Oldest first, the node's own position is last
+
+        batch_entry(mcts::node* node, path_history const& path) :
+        node(node),
+        history_size(path.last_positions(history, max_history)),
+        queued(std::chrono::steady_clock::now())
+        {
+        }
+    };
+}
+
+#endif //FIREFLY_PATH_HISTORY_H
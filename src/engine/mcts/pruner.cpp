@@ -0,0 +1,90 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "pruner.h"
+
+void mcts::tree_pruner::begin(mcts::node* root, memory& memory_, float cold_fraction, float max_prior)
+{
+    this->memory_ = &memory_;
+    this->cold_fraction = cold_fraction;
+    this->max_prior = max_prior;
+
+    pruned_subtrees = 0;
+    pruned_visits = 0;
+
+    stack.clear();
+    stack.push_back({root, 0});
+    memory_.count_live(root);
+    active = true;
+}
+
+
+bool mcts::tree_pruner::is_cold(mcts::node* parent, mcts::edge& edge, uint32_t most_visits) const
+{
+    auto child = edge.get_node();
+
+    // Solved subtrees and nodes still waiting for the network keep their state
+    if (child->is_solved() || !child->evaluated || child->visits_pending != 0)
+        return false;
+
+    return child->visit_count != most_visits &&
+           edge.P_ < max_prior &&
+           child->visit_count < parent->visit_count * cold_fraction;
+}
+
+
+bool mcts::tree_pruner::step(std::chrono::high_resolution_clock::time_point deadline)
+{
+    size_t count = 0;
+
+    while (!stack.empty())
+    {
+        if ((++count & 63) == 0 && std::chrono::high_resolution_clock::now() >= deadline)
+            return false;
+
+        auto [node, depth] = stack.back();
+        stack.pop_back();
+
+        uint32_t most_visits = 0;
+        for (auto& i : *node)
+            if (i.get_node())
+                most_visits = std::max(most_visits, i.get_node()->visit_count);
+
+        for (auto& i : *node)
+        {
+            auto child = i.get_node();
+            if (!child) continue;
+
+            if (depth > 0 && is_cold(node, i, most_visits))
+            {
+                pruned_subtrees++;
+                pruned_visits += child->visit_count;
+                i.set_node(nullptr);
+            }
+            else
+            {
+                memory_->count_live(child);
+                stack.push_back({child, uint16_t(depth + 1)});
+            }
+        }
+    }
+
+    active = false;
+    return true;
+}
@@ -0,0 +1,76 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef FIREFLY_PRUNER_H
+#define FIREFLY_PRUNER_H
+
+#include "node.h"
+#include "memory.h"
+#include <vector>
+#include <chrono>
+
+namespace mcts {
+
+    /*
+     * Detaches cold subtrees so long analysis fits in a fixed amount of node memory.
+     *
+     * A child is cold if it isn't the most visited child of its parent, its prior is below max_prior
+     * and it has fewer than cold_fraction of its parent's visits. Children of the root are never pruned.
+     *
+     * The edge of a pruned child goes back to being unexpanded, the parent's Q and N already include
+     * every visit of the subtree so nothing is lost there.
+     *
+     * The same walk counts the live bytes of every block (memory::count_live), afterwards
+     * memory::reclaim_blocks frees blocks that only hold detached nodes and compacts sparse ones.
+     *
+     * Works in bounded steps with the search paused, same as compaction.
+     */
+    struct tree_pruner
+    {
+        void begin(mcts::node* root, memory& memory_, float cold_fraction, float max_prior);
+
+        /*
+         * Walks the tree until it's done or the deadline passes, returns true when done.
+         */
+        bool step(std::chrono::high_resolution_clock::time_point deadline);
+
+        inline bool is_active() const
+        {
+            return active;
+        }
+
+        size_t pruned_subtrees = 0, pruned_visits = 0;
+
+    private:
+        struct entry
+        {
+            mcts::node* node;
+            uint16_t depth;
+        };
+
+        bool is_cold(mcts::node* parent, mcts::edge& edge, uint32_t most_visits) const;
+
+        std::vector<entry> stack;
+        memory* memory_ = nullptr;
+        float cold_fraction = 0, max_prior = 0;
+        bool active = false;
+    };
+}
+
+#endif //FIREFLY_PRUNER_H
@@ -32,6 +32,11 @@ using namespace std;
 
 std::atomic<int> solved_nodes = 0;
 
+namespace
+{
+    parking::site idle_workers_site("pausing workers"), full_batch_site("full shared batch"), ponder_site("ponderhit");
+}
+
 
 std::atomic<int> hash_collisions;
 std::atomic<int> num_transpositions;
@@ -39,20 +44,39 @@ std::atomic<int> batches;
 mcts::node* current_root;
 
 mcts::search::search(cxxopts::ParseResult& options) :
-thread_count(options["t"].as<int>()), c_puct(options["c"].as<float>()), c_puct_root(options["c_puct_root"].as<float>()),
-net_manager(options), dirichlet_epsilon(options["dirichlet_epsilon"].as<float>()), dirichlet_alpha(options["dirichlet_alpha"].as<float>()),
+net_manager(options), dirichlet_alpha(options["dirichlet_alpha"].as<float>()), dirichlet_epsilon(options["dirichlet_epsilon"].as<float>()),
+c_puct_root(options["c_puct_root"].as<float>()), c_puct(options["c"].as<float>()),
+speculative_children(std::max(0, options["speculation"].as<int>())),
+memory_(options["max_batch_size"].as<int>(), size_t(options["memory_block_size"].as<int>()) << 20, options["huge_pages"].as<bool>(),
+        options["node_alignment"].as<int>(), numa::parse_placement(options["numa_memory"].as<string>())),
+prune_hashfull(options["prune_hashfull"].as<int>()),
+compaction_threads(options["compaction_threads"].as<int>()), compaction_pause(options["compaction_pause"].as<int>()),
+traversals_per_thread(std::max(1, options["traversals"].as<int>())), thread_count(options["t"].as<int>()),
 deallocation_factor(options["deallocation_factor"].as<int>()), deallocation_minimum(options["deallocation_minimum"].as<int>()),
-memory_(options["max_batch_size"].as<int>())
+batch_control(options["max_batch_size"].as<int>(), options["t"].as<int>(), options["adaptive_batch"].as<bool>()),
+move_overhead(std::max(0, options["move_overhead"].as<int>()))
 {
     working = true;
     paused = true;
 
+    if (options["compaction_threads"].as<int>() <= 0)
+        compaction_threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+
+    set_memory_budget(size_t(options["node_memory"].as<int>()) << 20);
+
+    compaction_thread = std::jthread(&mcts::search::compaction_worker, this);
+
+    thread_pinning = numa::parse_pinning(options["pin_threads"].as<string>());
+    numa::report(numa::parse_placement(options["numa_memory"].as<string>()), thread_pinning,
+                 net_manager.has_node_backends());
 
 #ifdef SYNCHRONOUS_INFERENCE
-    for (int i = 0; i < thread_count; i++)
-        threads.emplace_back(std::jthread(&mcts::search::expand_tree_puct_worker_synchronous, this));
+    memory_.set_traversal_threads(thread_count);
+
+    for (size_t i = 0; i < thread_count; i++)
+        threads.emplace_back(std::jthread(&mcts::search::expand_tree_puct_worker_synchronous, this, i));
 #else
-    for (int i = 0; i < thread_count; i++)
+    for (size_t i = 0; i < thread_count; i++)
         threads.emplace_back(jthread(&mcts::search::expand_tree_puct_worker, this));
 #endif
 }
@@ -65,11 +89,20 @@ mcts::search::~search()
         paused = false;
         paused_cv.notify_all();
     }
+    batch_control.stop();
     threads.clear();
+
+    {
+        std::lock_guard l(compaction_mutex);
+        compaction_cv.notify_all();
+    }
+    compaction_thread.join();
 }
 
 bool mcts::search::initialize(string const& fen)
 {
+    pause_compaction();
+
     memory_.clear();
 
     game_has_ended = false;
@@ -80,10 +113,13 @@ bool mcts::search::initialize(string const& fen)
 
     past_roots.clear();
     past_roots.reserve(2048);
+    moves_played.clear();
 
     if (!root_board.from_fen(fen))
         return false;
 
+    game_positions.assign(1, root_board);
+
     chess::movegen_result moves;
 
     if (root_board.generate_moves(moves) != chess::game_state::playing)
@@ -95,23 +131,132 @@ bool mcts::search::initialize(string const& fen)
 
     ::current_root = current_root;
 
+    rebuild_root_history();
 
     return true;
 }
 
+void mcts::search::rebuild_root_history()
+{
+    static vector<mcts::node*> nodes;
+
+    // Nothing before the last irreversible move can be repeated, but the network sees the last 8 positions
+    bool reached_irreversible = false;
+
+    for (auto node = current_root; node && nodes.size() < game_positions.size(); node = node->parent)
+    {
+        nodes.push_back(node);
+
+        reached_irreversible |= !node->reversible_move;
+        if (reached_irreversible && nodes.size() >= batch_entry::max_history) break;
+    }
+
+    root_history.clear();
+
+    // Nodes don't store their board, the positions come from the game instead
+    for (size_t i = nodes.size(); i-- > 0;)
+        root_history.push(game_positions[game_positions.size() - 1 - i], nodes[i]->repetitions);
+
+    nodes.clear();
+}
+
 void mcts::search::free_memory()
 {
+    pause_compaction();
+
     if (!current_root->reversible_move &&
-        approximate_nodes_to_clear >= deallocation_minimum &&
+        approximate_nodes_to_clear >= size_t(deallocation_minimum) &&
         approximate_nodes_to_clear > (current_root->visit_count * deallocation_factor)){
-        current_root = memory_.free_unused(current_root, past_roots);
+        current_root = memory_.begin_compaction(current_root, past_roots);
+        ::current_root = current_root;
         approximate_nodes_to_clear = 0;
     }
 }
 
+void mcts::search::pause_compaction()
+{
+    // The worker checks the flag before every step, so this waits for one step at most
+    compaction_allowed = false;
+    std::lock_guard l(compaction_mutex);
+}
+
+void mcts::search::resume_compaction()
+{
+    {
+        std::lock_guard l(compaction_mutex);
+        compaction_allowed = true;
+    }
+    compaction_cv.notify_all();
+}
+
+void mcts::search::set_memory_budget(size_t bytes)
+{
+    pause_compaction();
+    memory_.set_budget(bytes);
+}
+
+void mcts::search::set_move_overhead(std::chrono::milliseconds overhead)
+{
+    move_overhead = std::max(0ms, overhead).count();
+}
+
+namespace
+{
+    constexpr float initial_cold_fraction = 1.f / 256, max_cold_fraction = 1.f / 8;
+    constexpr float cold_max_prior = .1f;
+}
+
+void mcts::search::prune_step()
+{
+    if (!pruner.is_active())
+    {
+        memory_.begin_liveness(current_root, past_roots);
+        pruner.begin(current_root, memory_, prune_cold_fraction, cold_max_prior);
+    }
+
+    if (!pruner.step(chrono::high_resolution_clock::now() + compaction_pause))
+        return;
+
+    cout << "info string pruned " << pruner.pruned_subtrees << " cold subtrees (" << pruner.pruned_visits <<
+         " visits), hashfull " << memory_.hashfull() << endl;
+
+    // Dead blocks are freed right away, sparse ones are compacted in the following steps
+    memory_.reclaim_blocks(current_root);
+    pruning_compaction = true;
+}
+
+void mcts::search::compaction_step()
+{
+    memory_.compaction_step(chrono::high_resolution_clock::now() + compaction_pause, compaction_threads);
+}
+
+void mcts::search::compaction_worker()
+{
+    std::unique_lock lock(compaction_mutex);
+
+    while (working)
+    {
+        compaction_cv.wait(lock, [this]() {
+            return !working || (compaction_allowed && memory_.is_compacting());
+        });
+
+        if (!working) break;
+
+        compaction_step();
+
+        // Give pause_compaction a chance to take the lock between steps
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+}
+
 
 bool mcts::search::make_move_external(string const& uci_move)
 {
+    pause_compaction();
+    complete_root();
+
     for (auto& i : *current_root)
     {
         if (i.move.to_uci_move() == uci_move)
@@ -123,13 +268,38 @@ bool mcts::search::make_move_external(string const& uci_move)
     return false;
 }
 
+bool mcts::search::take_back()
+{
+    pause_compaction();
+
+    auto parent = current_root->parent;
+
+    // Parents moved out of the arena lost their edges, see memory::begin_compaction
+    if (!parent || game_has_ended || moves_played.empty() || game_positions.size() < 2 ||
+        std::any_of(past_roots.begin(), past_roots.end(), [parent](auto& i) { return i.get() == parent; }))
+        return false;
+
+    approximate_nodes_to_clear -= std::min<size_t>(approximate_nodes_to_clear, parent->visit_count - current_root->visit_count);
+
+    current_root = parent;
+    moves_played.pop_back();
+    game_positions.pop_back();
+    root_board = game_positions.back();
+
+    ::current_root = current_root;
+    rebuild_root_history();
+
+    cout << "info Took back the last move, " << current_root->visit_count << " visits kept" << endl;
+    return true;
+}
+
 void mcts::search::advance_root(mcts::edge * edge_to_new_root)
 {
     auto& glog = logging::log("graph");
 
     if (glog.initialized)
     {
-        auto this_id = current_root->board.hash();
+        auto this_id = current_root->position_hash;
 
 
         if (!current_root->parent)
@@ -152,11 +322,11 @@ void mcts::search::advance_root(mcts::edge * edge_to_new_root)
 
                 if (i.is_terminal())
                 {
-                    auto b = current_root->board;
+                    auto b = root_board;
                     b.make_move(i.move);
                     child_id = b.hash();
                 }
-                else child_id = i.get_node()->board.hash();
+                else child_id = i.get_node()->position_hash;
 
                 glog << child_id << " [";
                 if (&i == edge_to_new_root) {
@@ -167,10 +337,10 @@ void mcts::search::advance_root(mcts::edge * edge_to_new_root)
                      i.move.to_uci_move() << '\n';
 
                 if (i.is_terminal())
-                    glog << "Terminal: True\nValue: " << i.terminal_value;
+                    glog << "Terminal: True\nValue: " << float(i.terminal_value);
                 else
                 {
-                    glog << "Terminal: False\nPrior: " << i.P_ << '\n' <<
+                    glog << "Terminal: False\nPrior: " << float(i.P_) << '\n' <<
                          "Value: " << i.get_value() << '\n' <<
                          "Visits: " << i.get_node()->visit_count << '\n' <<
                          "Solved: " << int(i.get_node()->solution) << '\n' <<
@@ -185,13 +355,13 @@ void mcts::search::advance_root(mcts::edge * edge_to_new_root)
             }
             else
             {
-                auto b = current_root->board;
+                auto b = root_board;
                 b.make_move(i.move);
                 child_id = b.hash();
 
                 glog << child_id << " [label=\"Move: " <<
                      i.move.to_uci_move() << '\n';
-                glog << "Prior: " << i.P_ << '\n'
+                glog << "Prior: " << float(i.P_) << '\n'
                      << "Unexpanded.";
 
                 glog << "\"];\n";
@@ -222,42 +392,67 @@ void mcts::search::advance_root(mcts::edge * edge_to_new_root)
         //current_root = (mcts::node*)edge_to_new_root;
 
         past_roots.push_back(std::make_unique<mcts::node>(*current_root));
-        current_root->board.make_move(edge_to_new_root->move);
+        root_board.make_move(edge_to_new_root->move);
+        game_positions.push_back(root_board);
         current_root->Q_ = edge_to_new_root->terminal_value;
         current_root->parent = past_roots.back().get();
         return;
     }
 
 
-    if (!edge_to_new_root->is_expanded()) {
-        if (!edge_to_new_root->expand(current_root, memory_))
+    auto new_root_board = root_board;
+    new_root_board.make_move(edge_to_new_root->move);
+
+    // A leaf that hasn't been evaluated yet gets its edges right away, the root needs them before the search
+    auto materialize_new_root = [&]()
+    {
+        auto leaf = edge_to_new_root->get_node();
+
+        if (leaf->has_edges())
+            return true;
+
+        chess::movegen_result moves;
+        auto state = new_root_board.generate_moves(moves);
+
+        if (state != chess::game_state::playing)
         {
-            cout << "info selected unexplored terminal node" << endl;
-            game_has_ended = true;
-            current_root = (mcts::node*)edge_to_new_root;
-            return;
+            leaf->make_terminal(state);
+            return false;
         }
+
+        return leaf->materialize(memory_, moves.moves, moves.moves_count) != nullptr;
+    };
+
+    if ((!edge_to_new_root->is_expanded() && !edge_to_new_root->expand(current_root, memory_, root_history)) ||
+        !materialize_new_root())
+    {
+        cout << "info selected unexplored terminal node" << endl;
+        game_has_ended = true;
+        current_root = (mcts::node*)edge_to_new_root;
+        root_board.make_move(edge_to_new_root->move);
+        game_positions.push_back(root_board);
+        return;
     }
 
 
     this->current_root = edge_to_new_root->get_node();
 
+    root_board.make_move(edge_to_new_root->move);
+    root_board.has_repeated = current_root->repetitions != 0;
+    game_positions.push_back(root_board);
+
     this->approximate_nodes_to_clear += current_root->parent->visit_count - current_root->visit_count;
 
     ::current_root = current_root;
+    rebuild_root_history();
+
     cout << "info Selected: " << edge_to_new_root->move.to_uci_move() << "  value = " << edge_to_new_root->get_value() << endl;
 }
 
 
 mcts::edge* mcts::search::best_move() const
 {
-    // Sort edges by value in ascending order
-    std::sort(current_root->begin(), current_root->end(), [](auto& a, auto& b)
-    {
-        return a.get_value() > b.get_value();
-    });
-
-    auto best_edge = current_root->begin();
+    auto best_edge = current_root->best_edge_by_value();
 
     return best_edge;
 
@@ -287,12 +482,12 @@ mcts::edge* mcts::search::best_move() const
 
     if (bml == 1) return best_edge;
 
-    for (auto it = current_root->begin() + 1; it != current_root->end(); it++)
+    for (auto it = current_root->begin(); it != current_root->end(); it++)
     {
         auto value = it->get_value();
 
-        // If the difference is more than .05, abort
-        if (abs(first_value - value) > .01f) break;
+        // Only moves about as good as the best one
+        if (it == best_edge || abs(first_value - value) > .01f) continue;
 
         auto moves_left = it->get_node() ? it->get_node()->moves_left : 1;
 
@@ -309,8 +504,77 @@ mcts::edge* mcts::search::best_move() const
 }
 
 
+void mcts::search::complete_pending_nodes()
+{
+    std::lock_guard l(incomplete_nodes_lock);
+
+    if (incomplete_nodes.empty())
+        return;
+
+    // Threads that selected the remainder after the first one queued the node with a prior of 0
+    std::sort(incomplete_nodes.begin(), incomplete_nodes.end(), [](auto& a, auto& b) {
+        return a.first != b.first ? a.first < b.first : a.second > b.second;
+    });
+
+    incomplete_nodes.erase(std::unique(incomplete_nodes.begin(), incomplete_nodes.end(), [](auto& a, auto& b) {
+        return a.first == b.first;
+    }), incomplete_nodes.end());
+
+    static vector<chess::move> moves;
+
+    for (auto [node, prior_mass] : incomplete_nodes)
+    {
+        // Nodes don't store their board, replay the moves from the root
+        for (auto n = node; n != current_root; n = n->parent)
+            moves.push_back(n->get_own_edge()->move);
+
+        auto board = root_board;
+        for (auto it = moves.rbegin(); it != moves.rend(); it++)
+            board.make_move(*it);
+
+        moves.clear();
+
+        auto completed = node->complete_edges(memory_, board, prior_mass);
+
+        if (!completed)
+        {
+            // Out of memory, the remainder stays and gets its prior back
+            for (auto& i : *node)
+                if (i.is_remainder())
+                    i.set_prior(prior_mass);
+
+            continue;
+        }
+
+        if (node == current_root)
+        {
+            current_root = completed;
+            ::current_root = current_root;
+        }
+    }
+
+    incomplete_nodes.clear();
+}
+
+void mcts::search::complete_root()
+{
+    for (auto& i : *current_root)
+    {
+        if (i.is_remainder())
+        {
+            incomplete_nodes.emplace_back(current_root, float(i.P_));
+            complete_pending_nodes();
+            return;
+        }
+    }
+}
+
+
 bool mcts::search::prepare_search()
 {
+    // The root always has all of its edges, for the noise and the move choice
+    complete_root();
+
     if (current_root->edge_count == 1)
         return false;
 
@@ -322,11 +586,11 @@ bool mcts::search::prepare_search()
     if (!current_root->evaluated)
     {
 #ifdef SYNCHRONOUS_INFERENCE
-        net_manager.blocking_inference({current_root});
+        net_manager.blocking_inference({batch_entry(current_root, root_history)});
         current_root->lock_count = 0;
         current_root->locking_tid = -1;
 #else
-        net_manager.add_to_eval_queue(current_root);
+        net_manager.add_to_eval_queue(batch_entry(current_root, root_history));
         net_manager.wait_for_node_evaluation(current_root);
 #endif
     }
@@ -336,7 +600,7 @@ bool mcts::search::prepare_search()
     /*
     for (auto& i : *current_root)
     {
-        cout << i.move.to_uci_move() << "  |  " << i.P_ << endl;
+        cout << i.move.to_uci_move() << "  |  " << float(i.P_) << endl;
     }
      */
 
@@ -367,19 +631,21 @@ bool mcts::search::prepare_search()
     return true;
 }
 
-void mcts::search::expand_tree_puct_worker_synchronous()
+void mcts::search::expand_tree_puct_worker_synchronous(size_t index)
 {
     static std::atomic<uint8_t> next_tid = 0;
 
+    // The CPU backends run their forward passes on this thread, their OpenMP teams inherit the CPUs
+    numa::pin_worker(index, thread_pinning);
+
     mcts::node::thread_id = next_tid++;
 
     if (mcts::node::thread_id == 255)
         mcts::node::thread_id = next_tid++;
 
 
-    mcts::node* edge_parent;
-    mcts::node* next_node;
-    mcts::edge* selected_edge;
+    traversal_scheduler scheduler;
+    std::vector<traversal> traversals;
 
     std::unique_lock pausing_lock(pausing_mutex);
 
@@ -396,80 +662,186 @@ void mcts::search::expand_tree_puct_worker_synchronous()
             if (!working) break;
         }
 
+        // Switched off by the batch controller, this thread's traversals already returned
+        if (!batch_control.is_active(index))
+        {
+            batch_control.wait_until_active(index);
+            continue;
+        }
+
         working_threads++;
+        memory_.begin_traversals(index);
 
-        int n_selection_fails = 0;
+        for (size_t i = 0; i < traversals_per_thread; i++)
+        {
+            traversals.push_back(playouts(scheduler, index));
+            scheduler.ready.push_back(traversals.back().handle);
+        }
 
-        while (!paused) {
+        // Traversals return once the search is paused, the ones waiting for the network have to finish first
+        while (true)
+        {
+            scheduler.run_ready();
 
-            edge_parent = current_root;
+            if (scheduler.waiting.empty())
+                break;
 
-            edge_parent->lock();
-            selected_edge = current_root->puct_select(c_puct_root);
+            wait_for_traversals(scheduler, index);
+        }
 
-            while (selected_edge && selected_edge->is_expanded()) {
+        traversals.clear();
+        memory_.end_traversals(index);
 
-                next_node = selected_edge->get_node();
-                edge_parent->unlock();
+        process_shared_batch();
+        working_threads--;
+        parking::notify(working_threads, idle_workers_site);
+    }
+}
 
-                // If a terminal node is hit (actually this shouldn't ever happen), reset the selection
-                if (selected_edge->is_terminal()) {
-                    edge_parent->unlock();
-                    edge_parent = current_root;
-                    edge_parent->lock();
-                    selected_edge = current_root->puct_select(c_puct_root);
-                    continue;
-                }
 
+mcts::traversal mcts::search::playouts(traversal_scheduler& scheduler, size_t thread_index)
+{
+    mcts::node* edge_parent;
+    mcts::node* next_node;
+    mcts::edge* selected_edge;
 
-                // If an unevaluated node is hit, the selection has to be stalled until the backend processes it.
-                if (!next_node->evaluated)
-                    uneval_hit(next_node);
+    path_history path;
+
+    path.assign(root_history);
 
-                edge_parent = next_node;
+    int n_selection_fails = 0;
+
+    while (!paused && batch_control.is_active(thread_index)) {
+
+        path.truncate(root_history.size());
+
+        bool reselect = false;
+        edge_parent = current_root;
+
+        edge_parent->lock();
+        selected_edge = current_root->puct_select(c_puct_root);
+
+        while (selected_edge && selected_edge->is_expanded()) {
+
+            next_node = selected_edge->get_node();
+            edge_parent->unlock();
+
+            // If a terminal node is hit (actually this shouldn't ever happen), reset the selection
+            if (selected_edge->is_terminal()) {
+                edge_parent->unlock();
+                path.truncate(root_history.size());
+                edge_parent = current_root;
                 edge_parent->lock();
-                selected_edge = edge_parent->puct_select(c_puct);
+                selected_edge = current_root->puct_select(c_puct_root);
+                continue;
             }
 
 
-            if (selected_edge) {
+            /*
+             * If an unevaluated node is hit, the traversal is suspended until the backend processes it.
+             * The node moves when it gets its edges, or it turns out to be terminal, so the edge is read again.
+             * An evaluated node without edges is a leaf that moved after the edge was read.
+             */
+            while (next_node && (!next_node->evaluated || !next_node->has_edges()))
+            {
+                if (!next_node->evaluated)
+                    co_await scheduler.evaluation_of(next_node);
+                next_node = selected_edge->get_node();
+            }
 
-                //for (selected_edge = edge_parent->begin(); selected_edge != edge_parent->end(); selected_edge++)
-                {
-                    n_selection_fails = 0;
+            if (!next_node)
+            {
+                edge_parent->cancel_pending_visits();
+                reselect = true;
+                break;
+            }
+
+            // Evaluated ahead of time, this selection is its first visit
+            if (next_node->visit_count == 0 && claim_speculative(edge_parent, next_node))
+            {
+                reselect = true;
+                break;
+            }
 
-                    bool res = selected_edge->expand(edge_parent, memory_);
-                    auto node = selected_edge->get_node();
+            edge_parent = next_node;
+            path.push(selected_edge->move, edge_parent->repetitions);
 
+            edge_parent->lock();
+            selected_edge = edge_parent->puct_select(c_puct);
+        }
+
+
+        // The selection ran into a leaf that turned out to be terminal or claimed a speculative node, edge_parent is unlocked
+        if (reselect)
+            continue;
+
+        // The moves behind a remainder edge are added back at the next pause, see complete_pending_nodes
+        if (selected_edge && selected_edge->is_remainder())
+        {
+            {
+                std::lock_guard l(incomplete_nodes_lock);
+                incomplete_nodes.emplace_back(edge_parent, float(selected_edge->P_));
+            }
+
+            // Keeps the other threads from selecting it again in the meantime
+            selected_edge->set_prior(0);
+
+            edge_parent->cancel_pending_visits();
+            edge_parent->unlock();
+            continue;
+        }
+
+        if (selected_edge) {
+
+            //for (selected_edge = edge_parent->begin(); selected_edge != edge_parent->end(); selected_edge++)
+            {
+                n_selection_fails = 0;
+
+                bool res = selected_edge->expand(edge_parent, memory_, path);
+                auto node = selected_edge->get_node();
 
 
-                    if (res) {
+
+                if (res) {
+
+                    // The node's own position, for the transposition check and the network
+                    path.push(selected_edge->move, node->repetitions);
 
 #ifdef TRANSPOSITION_TABLES_ENABLED
-                        auto transposition = memory_.transposition_check(node);
+                    auto transposition = memory_.transposition_check(node, path.top());
 
-                        if (transposition && transposition->evaluated)
-                        {
+                    if (transposition && transposition->evaluated)
+                    {
 
-                            //if (!transposition->evaluated)
-                            //    uneval_hit(transposition);
+                        //if (!transposition->evaluated)
+                        //    uneval_hit(transposition);
 
-                            transposition->lock();
+                        transposition->lock();
 
+                        // The leaf gets the transposition's edges instead of going to the network
+                        auto leaf = node;
+                        node = node->materialize(memory_, transposition);
+
+                        if (node)
+                        {
                             node->Q_ = transposition->Q_;
                             node->moves_left = transposition->moves_left;
-                            memcpy(node->begin(), transposition->begin(), node->edge_count * sizeof(mcts::edge));
+                        }
 
-                            transposition->unlock();
+                        transposition->unlock();
 
+                        if (node)
+                        {
                             node->visit_count = 1;
                             node->visits_pending = 0;
                             node->solution = solution_state::unsolved;
 
                             node->parent->update_value(-node->Q_);
 
+                            // Children aren't shared, terminal edges stay terminal
                             for (auto &i: *node)
-                                i.node_ = nullptr;
+                                if (!i.is_terminal())
+                                    i.set_node(nullptr);
 
 #ifdef DEBUG_CHECKS
                             node->transposition = true;
@@ -479,47 +851,92 @@ void mcts::search::expand_tree_puct_worker_synchronous()
                             num_transpositions++;
 
                             net_manager.nodes_processed++;
-                        } else
-#endif
-                            add_to_shared_batch(node);
-                    } else {
-                        //net_manager.blocking_inference(batch);
-                        //batch.clear();
-                        if (current_root->is_solved()) {
-                            nodes_to_expand = 0;
-                            paused = true;
-                            break;
                         }
+
+                        // The parent has been locked since the expansion, so no other thread has seen the leaf
+                        memory_.retire_leaf(leaf);
+                    } else
+#endif
+                    {
+                        add_to_shared_batch(node, path);
+                    }
+
+                    path.pop();
+                } else {
+                    //net_manager.blocking_inference(batch);
+                    //batch.clear();
+                    if (current_root->is_solved()) {
+                        nodes_to_expand = 0;
+                        paused = true;
+                        notify_search_event();
+                        break;
+                    }
+
+                    // No memory left for new nodes, expand_tree decides what to do
+                    if (memory_.is_exhausted())
+                    {
+                        paused = true;
+                        notify_search_event();
                     }
                 }
-                edge_parent->unlock();
             }
-            else
-            {
-                edge_parent->unlock();
+            edge_parent->unlock();
+        }
+        else
+        {
+            edge_parent->unlock();
 
-                if (current_root->is_solved() || edge_parent == current_root || ++n_selection_fails == 10) {
-                    nodes_to_expand = 0;
-                    paused = true;
-                    break;
-                }
+            if (current_root->is_solved() || edge_parent == current_root || ++n_selection_fails == 10) {
+                nodes_to_expand = 0;
+                paused = true;
+                notify_search_event();
+                break;
             }
         }
+    }
+}
 
 
-        _break_twice:
-        n_selection_fails = 0;
-        process_shared_batch();
-        working_threads--;
+void mcts::search::wait_for_traversals(traversal_scheduler& scheduler, size_t thread_index)
+{
+    // Nodes in the batch that's being filled only get evaluated once someone sends it, the ones waited on go first
+    bool send = false;
+
+    shared_batch_insertion_lock.lock();
+    for (auto& i : scheduler.waiting)
+    {
+        if (i.node->batch_generation != shared_batch_generation)
+            continue;
+
+        for (auto& entry : *shared_batch)
+        {
+            if (entry.node == i.node)
+            {
+                entry.priority = mcts::eval_priority::blocking;
+                send = true;
+                break;
+            }
+        }
     }
+    shared_batch_insertion_lock.unlock();
+
+    if (send)
+        process_shared_batch();
+
+    // Every traversal of the thread is suspended, and the ones on evaluated nodes let go of them
+    net_manager.wait_for_evaluation([this, &scheduler, thread_index]() {
+        bool woken = scheduler.wake_evaluated();
+        memory_.traversals_quiescent(thread_index);
+        return woken;
+    });
 }
 
 
-vector<mcts::node*>* mcts::search::get_buffer()
+vector<mcts::batch_entry>* mcts::search::get_buffer()
 {
     if (free_buffers.empty())
     {
-        auto new_buffer = new vector<mcts::node*>();
+        auto new_buffer = new vector<mcts::batch_entry>();
         new_buffer->reserve(net_manager.get_max_batch_size());
         all_buffers.push_back(new_buffer);
         return new_buffer;
@@ -533,22 +950,24 @@ vector<mcts::node*>* mcts::search::get_buffer()
 }
 
 
-void mcts::search::add_to_shared_batch(mcts::node *node)
+void mcts::search::add_to_shared_batch(mcts::node *node, path_history const& path)
 {
     shared_batch_insertion_lock.lock();
 
-    if (shared_batch->size() >= net_manager.get_max_batch_size()) {
+    if (shared_batch->size() >= size_t(net_manager.get_max_batch_size())) {
         shared_batch_insertion_lock.unlock();
-        while (shared_batch->size() >= net_manager.get_max_batch_size()) std::this_thread::yield();
+        parking::wait_until(shared_batch_generation, [this]() {
+            return shared_batch->size() < size_t(net_manager.get_max_batch_size());
+        }, full_batch_site);
         shared_batch_insertion_lock.lock();
     }
-    shared_batch->push_back(node);
+    shared_batch->emplace_back(node, path);
 
-    node->batch_pointer = shared_batch;
+    node->batch_generation = shared_batch_generation;
 
     shared_batch_insertion_lock.unlock();
 
-    if (shared_batch->size() >= net_manager.get_max_batch_size())
+    if (shared_batch->size() >= batch_control.flush_threshold())
         process_shared_batch();
 }
 
@@ -567,47 +986,219 @@ void mcts::search::process_shared_batch()
 
         shared_batch_insertion_lock.lock();
         std::swap(shared_batch, local_buffer);
+        uint16_t generation = shared_batch_generation++;
         shared_batch_insertion_lock.unlock();
+        parking::notify(shared_batch_generation, full_batch_site);
 
         shared_batch_inference_lock.unlock();
 
+        if (speculative_children && local_buffer->size() < batch_control.flush_threshold() && !net_manager.is_stopping())
+            speculate(*local_buffer, generation);
 
+        auto inference_start = chrono::steady_clock::now();
         net_manager.blocking_inference(*local_buffer);
+        batch_control.record_batch(local_buffer->size(),
+                                   chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - inference_start));
         batches++;
+
+        if (speculative_children)
+            add_speculation_seeds(*local_buffer);
+
+        if (time_.node_limit_reached(net_manager.nodes_processed))
+            notify_search_event();
+
         local_buffer->clear();
 
         std::lock_guard l(buffers_lock);
-        all_buffers.emplace_back(local_buffer);
+        free_buffers.emplace_back(local_buffer);
     }
     else shared_batch_inference_lock.unlock();
 }
 
+void mcts::search::speculate(vector<mcts::batch_entry>& batch, uint16_t generation)
+{
+    std::lock_guard l(speculation_lock);
+
+    vector<mcts::node*> line;
+
+    speculation_path.assign(root_history);
+
+    // Newest seeds first, every seed is used once
+    while (batch.size() < batch_control.flush_threshold() && !speculation_seeds.empty())
+    {
+        auto seed = speculation_seeds.back();
+        speculation_seeds.pop_back();
+
+        // Seeds below an earlier root aren't part of the tree anymore
+        line.clear();
+        for (auto node = seed; node && node != current_root; node = node->parent)
+            line.push_back(node);
+
+        if (line.empty() || line.back()->parent != current_root)
+            continue;
+
+        speculation_path.truncate(root_history.size());
+        for (auto i = line.rbegin(); i != line.rend(); i++)
+            speculation_path.push((*i)->get_own_edge()->move, (*i)->repetitions);
+
+        std::lock_guard seed_lock(*seed);
+
+        size_t added = 0;
+
+        for (auto& edge : *seed)
+        {
+            if (added == speculative_children || batch.size() >= batch_control.flush_threshold())
+                break;
+
+            if (edge.is_expanded() || edge.is_remainder())
+                continue;
+
+            // Stands in for the pending visits of a selection, a terminal child counts them as a real visit
+            for (auto node = seed; node != current_root; node = node->parent)
+                node->visits_pending++;
+
+            if (!edge.expand(seed, memory_, speculation_path))
+                continue;
+
+            auto leaf = edge.get_node();
+            leaf->batch_generation = generation;
+
+            speculation_path.push(edge.move, leaf->repetitions);
+            batch.emplace_back(leaf, speculation_path);
+            batch.back().priority = mcts::eval_priority::filler;
+            speculation_path.pop();
+
+            added++;
+        }
+    }
+}
+
+
+void mcts::search::add_speculation_seeds(vector<mcts::batch_entry> const& batch)
+{
+    std::lock_guard l(speculation_lock);
+
+    for (auto& i : batch)
+    {
+        // Evaluated leaves have moved, their edge points to the node with edges
+        if (i.priority == mcts::eval_priority::filler || !i.node->parent || i.node->get_own_edge()->is_terminal())
+            continue;
+
+        auto node = i.node->get_own_edge()->get_node();
+
+        if (node && node->evaluated && node->has_edges())
+            speculation_seeds.push_back(node);
+    }
+
+    // Only the most recent ones
+    auto max_seeds = size_t(net_manager.get_max_batch_size());
+    if (speculation_seeds.size() > max_seeds)
+        speculation_seeds.erase(speculation_seeds.begin(), speculation_seeds.end() - max_seeds);
+}
+
+
+void mcts::search::clear_speculation_seeds()
+{
+    std::lock_guard l(speculation_lock);
+    speculation_seeds.clear();
+}
+
+
+bool mcts::search::claim_speculative(mcts::node* parent, mcts::node* child)
+{
+    std::lock_guard l(*parent);
+
+    if (child->visit_count != 0 || !child->evaluated)
+        return false;
+
+    // Same as the network's result arriving for this selection
+    child->visit_count = 1;
+    parent->update_value(-child->Q_);
+
+    return true;
+}
+
+
 void mcts::search::stop_search()
 {
     cout << "info stopping search." << endl;
+    pondering = false;
+    parking::notify(pondering, ponder_site);
+    stop_requested_at = chrono::steady_clock::now().time_since_epoch().count();
+
+    // Workers in the middle of a batch drop what the network hasn't got to yet
+    net_manager.request_stop();
+
+    abort_expansion = true;
     paused = true;
-    while (working_threads);
+    notify_search_event();
+    wait_for_workers();
 }
 
-void mcts::search::expand_tree(std::chrono::duration<long, std::ratio<1l, 1000l> > time_left, size_t node_limit)
+void mcts::search::ponder_hit()
 {
-    cout << "info prepare search" << endl;
-    if (!prepare_search())
-        return;
+    pondering = false;
+    parking::notify(pondering, ponder_site);
+    notify_search_event();
+}
+
+void mcts::search::notify_search_event()
+{
+    // expand_tree checks what it waits for under the lock, so the change can't slip in between
+    {
+        std::lock_guard lock(search_event_mutex);
+    }
+    search_event_cv.notify_all();
+}
 
+void mcts::search::wait_for_ponderhit()
+{
+    parking::wait_until(pondering, [this]() {
+        return !pondering;
+    }, ponder_site);
+}
 
-    auto initial_time_limit = time_left / 20;
+void mcts::search::wait_for_workers()
+{
+    parking::wait_until(working_threads, [this]() {
+        return working_threads == 0;
+    }, idle_workers_site);
+}
 
-    auto start = chrono::high_resolution_clock::now();
-    auto end = start + initial_time_limit - 10ms;
+void mcts::search::expand_tree(search_limits const& limits)
+{
+    pause_compaction();
 
+    pondering = limits.ponder;
+
+    cout << "info prepare search" << endl;
+    if (!prepare_search())
+    {
+        // The move is already known, but a ponder search can't end before the ponderhit
+        wait_for_ponderhit();
+        return;
+    }
+
+    auto start = chrono::steady_clock::now();
 
     hash_collisions = 0;
     num_transpositions = 0;
     net_manager.time_spent_waiting = 0;
     batches = 0;
     net_manager.reset_nps();
-    this->nodes_to_expand = node_limit;
+    parking::reset();
+    net_manager.reset_latency();
+    net_manager.reset_bucket_latency();
+    net_manager.clear_stop();
+    stop_requested_at = 0;
+    batch_control.start(net_manager.nodes_processed);
+    this->nodes_to_expand = -1;
+    abort_expansion = false;
+    prune_cold_fraction = initial_cold_fraction;
+
+    time_.start(limits, chrono::milliseconds(move_overhead.load()), net_manager.nodes_processed,
+                current_root->visit_count);
+    bool clock_running = !limits.ponder;
 
     pausing_mutex.lock();
     paused = false;
@@ -616,9 +1207,6 @@ void mcts::search::expand_tree(std::chrono::duration<long, std::ratio<1l, 1000l>
 
     cout << "info unpaused" << endl;
 
-
-    bool timemod = false;
-
     int counter = 0;
     do
     {
@@ -626,61 +1214,146 @@ void mcts::search::expand_tree(std::chrono::duration<long, std::ratio<1l, 1000l>
             net_manager.print_pipeline_information(cout);
             cout << "  |  Solved: " << solved_nodes << "  |  Transpositions: " << num_transpositions <<
             "  |  Average batch size: " << float(net_manager.nodes_processed) / batches << endl;
+            cout << "info hashfull " << memory_.hashfull() << endl;
             counter = 0;
         }
-        this_thread::sleep_for(100ms);
 
-        if (std::chrono::high_resolution_clock::now() >= end)
+        // A stop, the ponderhit, a pause by the workers or the node limit wake this up right away, see notify_search_event
         {
-            stop_search();
-            break;
+            std::unique_lock lock(search_event_mutex);
+            search_event_cv.wait_until(lock, std::min(chrono::steady_clock::now() + 100ms, time_.next_deadline()), [&]() {
+                return paused || (!clock_running && !pondering) || time_.node_limit_reached(net_manager.nodes_processed);
+            });
         }
 
-        if (!timemod) {
-            int most_visited = 0;
-            int second_most_visited = 0;
-            floatx best_value = -1, second_best_value;
-            for (auto &i: *current_root) {
-                if (i.get_node()) {
-                    //best_value = max(best_value, i.get_node()->average_value());
+        // The limits apply from the ponderhit on, the workers never noticed
+        if (!clock_running && !pondering && !paused)
+        {
+            auto real_limits = limits;
+            real_limits.ponder = false;
 
-                    auto val = i.get_value();
+            time_.start(real_limits, chrono::milliseconds(move_overhead.load()), net_manager.nodes_processed,
+                        current_root->visit_count);
+            clock_running = true;
 
-                    if (val > best_value) {
-                        second_best_value = best_value;
-                        best_value = val;
-                    } else if (val > second_best_value)
-                        second_best_value = val;
+            start = chrono::steady_clock::now();
+            cout << "info [time] ponderhit, " << current_root->visit_count << " visits kept" << endl;
+        }
 
+        batch_control.update(net_manager.nodes_processed);
 
-                    auto visits = i.get_node()->visit_count;
-                    if (visits > most_visited) {
-                        second_most_visited = most_visited;
-                        most_visited = visits;
-                    } else if (visits > second_most_visited) {
-                        second_most_visited = visits;
-                    }
-                }
+        if (!paused)
+        {
+            auto reason = time_.check(current_root, net_manager.nodes_processed);
+
+            if (reason != time_manager::reason::none)
+            {
+                cout << "info [time] " << time_manager::describe(reason) << " after "
+                     << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count()
+                     << "ms" << endl;
+                stop_search();
+                break;
             }
+        }
+
+        //region Node memory budget
+
+        if (memory_.near_budget())
+        {
+            paused = true;
+            wait_for_workers();
+            clear_speculation_seeds();
+
+            // Before any node moves, the queue points to nodes
+            complete_pending_nodes();
 
-            if (abs(best_value - second_best_value) < .1) {
-                end += initial_time_limit / 2;
-                timemod = true;
-            } else if (abs(best_value - second_best_value) > .3 && most_visited > 512) {
+            // Finishing an unfinished compaction is the only way to get memory back during a search
+            if (memory_.is_compacting())
+                memory_.compaction_step(chrono::high_resolution_clock::time_point::max(), compaction_threads);
 
-                end -= initial_time_limit / 2;
-                timemod = true;
-                //cout << "Aborting.." << endl;
-                //stop_search();
-                //break;
+            if (memory_.near_budget()) {
+                cout << "info string node memory budget reached (hashfull " << memory_.hashfull() << "), stopping search" << endl;
+                break;
+            }
+
+            if (nodes_to_expand != 0 && !abort_expansion) {
+                pausing_mutex.lock();
+                paused = false;
+                paused_cv.notify_all();
+                pausing_mutex.unlock();
+            }
+            continue;
+        }
+
+        //endregion
+
+        //region Pruning cold subtrees
+
+        if (pruning_compaction && !memory_.is_compacting())
+        {
+            pruning_compaction = false;
+
+            if (memory_.hashfull() >= prune_hashfull)
+                prune_cold_fraction = std::min(max_cold_fraction, prune_cold_fraction * 2);
+        }
+
+        bool prune = prune_hashfull && memory_.has_budget() && !memory_.is_compacting() &&
+                     (pruner.is_active() || memory_.hashfull() >= prune_hashfull);
+
+        //endregion
+
+        bool complete;
+        {
+            std::lock_guard l(incomplete_nodes_lock);
+            complete = !incomplete_nodes.empty();
+        }
+
+        // Move a bit of the tree out of from-space (or prune it), the workers have to be idle while nodes move
+        if ((memory_.is_compacting() || prune || complete) && !paused)
+        {
+            paused = true;
+            wait_for_workers();
+            clear_speculation_seeds();
+
+            complete_pending_nodes();
+
+            if (prune)
+                prune_step();
+            else if (memory_.is_compacting())
+                compaction_step();
+
+            // Unless the search was stopped or finished in the meantime
+            if (nodes_to_expand != 0 && !abort_expansion) {
+                pausing_mutex.lock();
+                paused = false;
+                paused_cv.notify_all();
+                pausing_mutex.unlock();
             }
         }
     }
-    while (working_threads);
+    while (working_threads || !paused);
 
 
     process_shared_batch();
+    clear_speculation_seeds();
+    complete_pending_nodes();
+
+    if (stop_requested_at)
+    {
+        auto stopped = chrono::steady_clock::time_point(chrono::steady_clock::duration(stop_requested_at));
+        cout << "info [search] " << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - stopped).count()
+             << "ms from the stop to the end of the search" << endl;
+    }
+
+    parking::report(cout);
+    net_manager.report_latency(cout);
+    net_manager.report_bucket_latency(cout);
 
+    batch_control.stop();
+    batch_control.report(cout);
+
+    // Out of node memory while pondering, the best move still has to wait for the ponderhit
+    wait_for_ponderhit();
 
 
     float wait_time = net_manager.time_spent_waiting;
@@ -698,13 +1371,6 @@ bool mcts::search::is_searching() const {
     return working_threads != 0;
 }
 
-void mcts::search::uneval_hit(mcts::node *node_)
-{
-    if (node_->batch_pointer == shared_batch)
-        process_shared_batch();
-
-    net_manager.wait_for_node_evaluation(node_);
-}
 
 
 
@@ -24,6 +24,10 @@
 #include <thread>
 #include <engine/neural/network_manager.h>
 #include <engine/mcts/memory.h>
+#include <engine/mcts/pruner.h>
+#include <engine/mcts/traversal.h>
+#include <engine/mcts/batch_controller.h>
+#include <engine/mcts/time_manager.h>
 #include <cxxopts.hpp>
 
 namespace mcts {
@@ -39,7 +43,9 @@ namespace mcts {
 
         float c_puct_root, c_puct;
 
+        // Position of current_root and every position of the game before it
         chess::board root_board;
+        std::vector<chess::board> game_positions;
         bool game_has_ended = false;
 
         search(cxxopts::ParseResult&);
@@ -54,6 +60,16 @@ namespace mcts {
 
         void advance_root(mcts::edge * edge_to_new_root);
 
+        /*
+         * Makes the parent of current_root the root again, with the rest of its subtree (a ponder miss).
+         * Returns false if the parent isn't in the tree anymore, compactions and pruning keep only a copy of it.
+         */
+        bool take_back();
+
+        // History of the game from the last irreversible move up to and including current_root
+        path_history root_history;
+        void rebuild_root_history();
+
 
 
         /*
@@ -63,27 +79,121 @@ namespace mcts {
 
         bool prepare_search();
 
-        void expand_tree(std::chrono::duration<long, std::ratio<1l, 1000l> > time_left, size_t node_limit=-1);
+        void expand_tree(search_limits const& limits);
 
         void stop_search();
 
+        // Starts the clock of a ponder search, which keeps going with everything it found so far
+        void ponder_hit();
+
         //endregion
+
+        /*
+         * Starts compacting the tree below current_root if enough nodes are dead,
+         * the compaction continues in bounded steps during the search and in the background.
+         */
         void free_memory();
 
+        // Lets an unfinished compaction continue in the background until the next call into the search
+        void resume_compaction();
+
+        // Limits node memory to bytes, 0 for no limit. The search stops expanding when it's close to the limit.
+        void set_memory_budget(size_t bytes);
+
+        // Time kept back from every move for communication with the GUI, see time_manager
+        void set_move_overhead(std::chrono::milliseconds overhead);
+
         bool is_searching() const;
     private:
 
-        vector<mcts::node*>* get_buffer();
+        vector<mcts::batch_entry>* get_buffer();
 
 
-        void uneval_hit(mcts::node* node_);
 
         void process_shared_batch();
-        void add_to_shared_batch(mcts::node* node);
+
+        /*
+         * Nodes whose remainder edge (see mcts::edge_limit) was selected, with the remainder's prior.
+         * They get all of their edges back while the workers are paused, since the nodes move.
+         */
+        std::vector<std::pair<mcts::node*, float>> incomplete_nodes;
+        std::mutex incomplete_nodes_lock;
+
+        void complete_pending_nodes();
+        void complete_root();
+
+        // path has to end with the node's position
+        void add_to_shared_batch(mcts::node* node, path_history const& path);
+
+        /*
+         * Speculation fills the free slots of underfilled batches with the unexpanded children (highest priors first)
+         * of recently evaluated nodes, at most speculative_children per node, 0 disables it.
+         * They're evaluated without a visit, visit_count stays 0 until a selection reaches one and claims it.
+         * Seeds are only valid until nodes move, expand_tree drops them whenever the workers pause.
+         */
+        void speculate(vector<mcts::batch_entry>& batch, uint16_t generation);
+        void add_speculation_seeds(vector<mcts::batch_entry> const& batch);
+        bool claim_speculative(mcts::node* parent, mcts::node* child);
+        void clear_speculation_seeds();
+
+        size_t speculative_children;
+        std::vector<mcts::node*> speculation_seeds;
+        std::mutex speculation_lock;
+        path_history speculation_path;
 
         memory memory_;
+
+        /*
+         * Compaction steps run with the search paused, for at most compaction_pause at a time.
+         * pause_compaction must be called before touching the tree outside of a search,
+         * it returns once the background step in progress (if any) is done.
+         */
+        void pause_compaction();
+        void compaction_step();
+        void compaction_worker();
+
+        /*
+         * With a node memory budget, cold subtrees are pruned once hashfull reaches prune_hashfull (0 disables it).
+         * prune_cold_fraction doubles whenever pruning and reclaiming blocks doesn't get below it.
+         */
+        void prune_step();
+
+        tree_pruner pruner;
+        int prune_hashfull;
+        float prune_cold_fraction;
+        bool pruning_compaction = false;
+
+        size_t compaction_threads;
+        std::chrono::milliseconds compaction_pause;
+        std::atomic<bool> compaction_allowed = false;
+        std::mutex compaction_mutex;
+        std::condition_variable compaction_cv;
+        std::jthread compaction_thread;
+
         std::atomic<size_t> working_threads;
-        void expand_tree_puct_worker_synchronous();
+
+        // Returns once every worker has noticed the pause
+        void wait_for_workers();
+
+        // Returns once pondering is over, after a ponderhit or a stop
+        void wait_for_ponderhit();
+
+        // Wakes expand_tree when the search has to stop or pause, or the clock has to start, before its tick ends
+        void notify_search_event();
+        std::mutex search_event_mutex;
+        std::condition_variable search_event_cv;
+
+        // index decides the CPUs the worker is pinned to, see numa::pin_worker
+        void expand_tree_puct_worker_synchronous(size_t index);
+        numa::pinning thread_pinning;
+
+        /*
+         * Every worker runs traversals_per_thread playout loops as coroutines, see mcts::traversal.
+         * A playout that runs into an unevaluated node suspends, the worker only blocks once all of its traversals wait.
+         */
+        traversal playouts(traversal_scheduler& scheduler, size_t thread_index);
+        void wait_for_traversals(traversal_scheduler& scheduler, size_t thread_index);
+        size_t traversals_per_thread;
 
 
         //void expand_tree_probabilistic_worker();
@@ -104,13 +214,22 @@ namespace mcts {
 
 
         bool paused = true;
+        std::atomic<bool> pondering = false; // Until ponder_hit or stop_search
+        std::atomic<std::chrono::steady_clock::rep> stop_requested_at = 0; // Since the clock's epoch, 0 unless stopped
         std::mutex pausing_mutex;
         std::condition_variable paused_cv;
 
         std::mutex shared_batch_inference_lock, shared_batch_insertion_lock;
-        vector<mcts::node*>* shared_batch;
+        vector<mcts::batch_entry>* shared_batch;
+        std::atomic<uint16_t> shared_batch_generation = 0; // See node::batch_generation, changes whenever the batch is sent
+
+        std::vector<vector<mcts::batch_entry>*> free_buffers, all_buffers;
+
+        // Size at which the shared batch is sent and the number of workers that run
+        batch_controller batch_control;
 
-        std::vector<vector<mcts::node*>*> free_buffers, all_buffers;
+        time_manager time_;
+        std::atomic<std::chrono::milliseconds::rep> move_overhead;
     };
 
 };
@@ -0,0 +1,153 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "time_manager.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+
+void mcts::time_manager::start(search_limits const& limits, chrono::milliseconds move_overhead, uint64_t nodes_processed,
+                               uint32_t root_visits)
+{
+    start_time = chrono::steady_clock::now();
+    start_nodes = nodes_processed;
+    start_visits = root_visits;
+    node_limit = limits.ponder ? 0 : limits.nodes;
+    instability = 0;
+    has_best = false;
+
+    timed = !limits.infinite && !limits.ponder && (limits.movetime.count() > 0 || limits.time_left.count() > 0);
+    can_stop_early = false;
+
+    if (!timed)
+        return;
+
+    if (limits.movetime.count() > 0)
+    {
+        optimum = maximum = std::max(0ms, limits.movetime - move_overhead);
+    }
+    else
+    {
+        auto available = std::max(0ms, limits.time_left - move_overhead);
+        int moves = limits.moves_to_go > 0 ? limits.moves_to_go : default_moves_to_go;
+
+        optimum = available / moves + limits.increment * 3 / 4;
+
+        // Right before the time control nearly all of the time is there to use
+        maximum = limits.moves_to_go == 1 ? available * 9 / 10 : std::min(optimum * 3, available / 2);
+        optimum = std::min(optimum, maximum);
+
+        can_stop_early = true;
+    }
+
+    optimum_deadline = start_time + optimum;
+    maximum_deadline = start_time + maximum;
+
+    cout << "info [time] optimum " << optimum.count() << "ms, maximum " << maximum.count() << "ms" << endl;
+}
+
+
+mcts::time_manager::reason mcts::time_manager::check(node* root, uint64_t nodes_processed)
+{
+    if (node_limit_reached(nodes_processed))
+        return reason::nodes;
+
+    if (!timed)
+        return reason::none;
+
+    auto now = chrono::steady_clock::now();
+
+    if (now >= maximum_deadline)
+        return reason::time;
+
+    // best_move plays the best valued move, the most visited one is the one that's hard to overtake
+    edge* best_valued = nullptr, *most_visited = nullptr;
+    float best_value = 0;
+    uint32_t most_visits = 0, second_visits = 0;
+
+    for (auto& i : *root)
+    {
+        auto value = i.get_value();
+        if (!best_valued || value > best_value)
+        {
+            best_valued = &i;
+            best_value = value;
+        }
+
+        auto child = i.get_node();
+        if (!child)
+            continue;
+
+        uint32_t visits = child->visit_count;
+        if (visits > most_visits)
+        {
+            second_visits = most_visits;
+            most_visits = visits;
+            most_visited = &i;
+        }
+        else if (visits > second_visits)
+            second_visits = visits;
+    }
+
+    if (!best_valued)
+        return reason::none;
+
+    instability *= instability_decay;
+    if (has_best && !(best_valued->move == last_best))
+        instability += 1;
+
+    last_best = best_valued->move;
+    has_best = true;
+
+    // An unstable best move gets up to max_instability times the optimum on top
+    auto extended = chrono::duration_cast<chrono::milliseconds>(optimum * (1 + std::min(instability, max_instability)));
+    optimum_deadline = start_time + std::min(extended, maximum);
+
+    if (now >= optimum_deadline)
+        return reason::time;
+
+    if (can_stop_early && most_visited == best_valued)
+    {
+        float elapsed = chrono::duration<float>(now - start_time).count();
+        float remaining = chrono::duration<float>(optimum_deadline - now).count();
+
+        // Visits gathered while pondering count towards the lead, but not towards the rate
+        float lead = float(most_visits) - float(second_visits);
+        float new_visits = float(int64_t(root->visit_count) - int64_t(start_visits));
+
+        if (elapsed > 0 && new_visits > 0 && lead > new_visits / elapsed * remaining)
+            return reason::decided;
+    }
+
+    return reason::none;
+}
+
+
+const char* mcts::time_manager::describe(reason r)
+{
+    switch (r)
+    {
+        case reason::time: return "out of time";
+        case reason::decided: return "best move decided";
+        case reason::nodes: return "node limit reached";
+        default: return "";
+    }
+}
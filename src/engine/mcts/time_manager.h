@@ -0,0 +1,98 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_TIME_MANAGER_H
+#define FIREFLY_TIME_MANAGER_H
+
+#include <engine/mcts/node.h>
+#include <chrono>
+#include <cstdint>
+
+namespace mcts {
+
+    /*
+     * The limits of a UCI go command, for the side to move. Without a time, movetime or node limit the search is infinite.
+     * A ponder search has no limits until the ponderhit, then these apply from that moment on.
+     */
+    struct search_limits
+    {
+        std::chrono::milliseconds time_left{0}, increment{0}, movetime{0};
+        int moves_to_go = 0;
+        uint64_t nodes = 0;
+        bool infinite = false, ponder = false;
+    };
+
+    /*
+     * Decides when a search ends.
+     *
+     * On the clock every move gets an optimum time, its share of the time left (minus move_overhead) plus most of the
+     * increment, and a maximum it never goes beyond. The search ends at the optimum, later while the best move keeps
+     * changing (instability, decays every check) and earlier once the best move is decided: the most visited move
+     * is also the best valued one and the runner-up couldn't catch up before the optimum, even if it got every root visit
+     * at the rate since start.
+     * movetime is spent whole, node limits count evaluated nodes.
+     * Time and nodes count from start, visits gathered before it (while pondering) are kept and count towards a decision.
+     */
+    struct time_manager
+    {
+        enum class reason : uint8_t
+        {
+            none,
+            time,
+            decided,
+            nodes
+        };
+
+        // root_visits is the root's visit count at the start, the rate of visits is measured from it
+        void start(search_limits const& limits, std::chrono::milliseconds move_overhead, uint64_t nodes_processed,
+                   uint32_t root_visits);
+
+        // Called by the search's main loop about every 100ms, reason::none to keep searching
+        reason check(node* root, uint64_t nodes_processed);
+
+        inline bool node_limit_reached(uint64_t nodes_processed) const
+        {
+            return node_limit && nodes_processed - start_nodes >= node_limit;
+        }
+
+        // The latest point the next check is needed by
+        inline std::chrono::steady_clock::time_point next_deadline() const
+        {
+            return timed ? std::min(optimum_deadline, maximum_deadline) : std::chrono::steady_clock::time_point::max();
+        }
+
+        static const char* describe(reason r);
+
+    private:
+        static constexpr int default_moves_to_go = 30;
+        static constexpr float max_instability = 2, instability_decay = 0.9;
+
+        bool timed = false, can_stop_early = false;
+        uint64_t node_limit = 0, start_nodes = 0;
+        uint32_t start_visits = 0;
+
+        std::chrono::steady_clock::time_point start_time, optimum_deadline, maximum_deadline;
+        std::chrono::milliseconds optimum{0}, maximum{0};
+
+        float instability = 0;
+        chess::move last_best{};
+        bool has_best = false;
+    };
+}
+
+#endif //FIREFLY_TIME_MANAGER_H
@@ -0,0 +1,140 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_TRAVERSAL_H
+#define FIREFLY_TRAVERSAL_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <vector>
+#include "node.h"
+
+namespace mcts {
+
+    /*
+     * Playouts of a tree traversal thread run as coroutines, a playout that runs into a node still waiting
+     * for the network suspends instead of blocking the thread, and the thread moves on to its other traversals.
+     *
+     * A traversal starts suspended and is destroyed with its handle, it runs until it returns.
+     */
+    struct traversal
+    {
+        struct promise_type
+        {
+            traversal get_return_object()
+            {
+                return traversal(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        explicit traversal(std::coroutine_handle<promise_type> handle) : handle(handle)
+        {
+        }
+
+        traversal(traversal&& other) noexcept : handle(std::exchange(other.handle, nullptr))
+        {
+        }
+
+        traversal(traversal const&) = delete;
+        traversal& operator=(traversal const&) = delete;
+
+        ~traversal()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+
+    /*
+     * The traversals of a single thread, they only ever run on that thread so nothing here is locked.
+     * Traversals never hold a node lock while suspended, which is why they can share the thread's node::thread_id.
+     */
+    struct traversal_scheduler
+    {
+        struct waiting_traversal
+        {
+            const mcts::node* node;
+            std::coroutine_handle<> handle;
+        };
+
+        // Suspends the traversal until node is evaluated, only awaited for nodes that aren't
+        struct evaluation_awaiter
+        {
+            traversal_scheduler& scheduler;
+            const mcts::node* node;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                scheduler.waiting.push_back({node, handle});
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        inline evaluation_awaiter evaluation_of(const mcts::node* node)
+        {
+            return {*this, node};
+        }
+
+        // Resumes traversals until every one of them is done or waiting
+        inline void run_ready()
+        {
+            while (!ready.empty())
+            {
+                auto handle = ready.back();
+                ready.pop_back();
+                handle.resume();
+            }
+        }
+
+        /*
+         * Moves traversals whose node has been evaluated to the ready ones, returns true if there are any.
+         * evaluated is set under network_manager::node_processed_lock, which has to be held.
+         */
+        bool wake_evaluated()
+        {
+            for (size_t i = waiting.size(); i-- > 0;)
+            {
+                if (waiting[i].node->evaluated)
+                {
+                    ready.push_back(waiting[i].handle);
+                    waiting[i] = waiting.back();
+                    waiting.pop_back();
+                }
+            }
+
+            return !ready.empty();
+        }
+
+        std::vector<std::coroutine_handle<>> ready;
+        std::vector<waiting_traversal> waiting;
+    };
+}
+
+#endif //FIREFLY_TRAVERSAL_H
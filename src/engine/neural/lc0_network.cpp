@@ -114,12 +114,12 @@ torch::Tensor ResLayerImpl::forward(torch::Tensor x)
     return T::relu(x + all_layers->forward(x));
 }
 
-LC0NetworkImpl::LC0NetworkImpl() : input_convolution(nullptr), device(torch::DeviceType::CPU){
+LC0NetworkImpl::LC0NetworkImpl() : device(torch::DeviceType::CPU), input_convolution(nullptr){
 
 }
 
-LC0NetworkImpl::LC0NetworkImpl(std::string const& weights_file, torch::Device device, bool use_fp16) : input_convolution(nullptr),
-device(device)
+LC0NetworkImpl::LC0NetworkImpl(std::string const& weights_file, torch::Device device, bool use_fp16) : device(device),
+input_convolution(nullptr)
 {
     int Filters, SEChannels, Blocks;
     auto NetworkDtype = use_fp16 ? T::Dtype::Half : T::Dtype::Float;
@@ -160,7 +160,7 @@ device(device)
         if (kernel_size != kernel_size_f)
             throw std::logic_error("Weights size mismatch.");
 
-        if ((in_c * out_c * kernel_size * kernel_size) != input_weights.size())
+        if (size_t(in_c * out_c * kernel_size * kernel_size) != input_weights.size())
         {
             throw std::logic_error("Weights size mismatch: " +
             to_string(in_c * out_c * kernel_size * kernel_size) + " != " +
@@ -186,7 +186,7 @@ device(device)
     auto read_fc = [NetworkDtype, device](vector<float> const& input_weights,
                                   vector<float> const& input_biases, int in_c, int out_c, nn::Linear& fc)
     {
-        if (input_biases.size() != out_c)
+        if (input_biases.size() != size_t(out_c))
             throw std::invalid_argument(
                     "Input bias size (" +
                     to_string(input_biases.size()) +
@@ -296,6 +296,23 @@ device(device)
     this->register_module("moves_left_head", moves_left_head);
 }
 
+LC0Network lc0::share_weights(LC0Network const& network)
+{
+    LC0Network instance;
+
+    instance->device = network->device;
+    instance->expected_dtype = network->expected_dtype;
+    instance->input_format = network->input_format;
+
+    instance->input_convolution = instance->register_module("input_convolution", network->input_convolution);
+    instance->residual_tower = instance->register_module("residual_tower", network->residual_tower);
+    instance->value_head = instance->register_module("value_head", network->value_head);
+    instance->policy_head = instance->register_module("policy_head", network->policy_head);
+    instance->moves_left_head = instance->register_module("moves_left_head", network->moves_left_head);
+
+    return instance;
+}
+
 NetworkOutput LC0NetworkImpl::forward(torch::Tensor input_planes)
 {
     auto x = T::relu(input_convolution(input_planes));
@@ -108,5 +108,12 @@ namespace lc0
     };
 
     TORCH_MODULE(LC0Network);
+
+    /*
+     * A new instance of an already loaded network, with its own n_user_threads but the same submodules,
+     * so the weights are shared instead of copied. Forward passes only read the weights,
+     * instances can run at the same time.
+     */
+    LC0Network share_weights(LC0Network const& network);
 };
 #endif //FIREFLY_LC0_NETWORK_H
@@ -27,9 +27,15 @@
 #include <mutex>
 #include <condition_variable>
 #include <random>
+#include <numeric>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <span>
 
 #include <engine/neural/lc0_network.h>
 #include <engine/mcts/node.h>
+#include <utils/numa.h>
 
 #include <c10/cuda/CUDAStream.h>
 
@@ -55,17 +61,34 @@ struct network_manager
        min_batch_size may be ignored if there is one or more tree traversal thread waiting for a node to be evaluated
     */
     network_manager(cxxopts::ParseResult& options) :
+    softmax_temperature(options["softmax_temperature"].as<float>()),
     max_batch_size(options["max_batch_size"].as<int>()),
 #ifndef SYNCHRONOUS_INFERENCE
     min_batch_size(min_batch_size),
     max_input_queue_size(max_input_queue_size),
     max_nn_input_queue_size(max_nn_input_batch_queue_size),
 #endif
-    softmax_temperature(options["softmax_temperature"].as<float>()),
     cpu_device(torch::DeviceType::CPU)
     {
         softmax_temperature_reciprocal = 1/softmax_temperature;
 
+        if (options["batch_buckets"].as<bool>())
+        {
+            for (size_t size = 8; size < max_batch_size; size *= 2)
+            {
+                batch_buckets.push_back(size);
+                if (size + size / 2 < max_batch_size)
+                    batch_buckets.push_back(size + size / 2);
+            }
+
+            batch_buckets.push_back(max_batch_size);
+        }
+
+        bucket_warmup_us.assign(batch_buckets.size(), 0);
+
+        edge_limit.max_edges = std::max(0, options["max_edges"].as<int>());
+        edge_limit.prior_mass = options["edge_prior_mass"].as<float>();
+
         auto device = options["device"].as<string>();
         auto weights_file = options["n"].as<string>();
 
@@ -79,9 +102,12 @@ struct network_manager
             for (int i = 0; i < torch::cuda::device_count(); i++)
                 add_backend(Network(weights_file, torch::Device(torch::kCUDA, i), true));
         }
+        else if (device == "cpu" && options["numa_backends"].as<bool>() && numa::get_topology().nodes() > 1)
+            add_node_backends(weights_file, options["cpu_inference_threads"].as<int>(), std::max(1, options["cpu_backends"].as<int>()));
         else if (device == "cpu")
         {
             auto n_threads = options["cpu_inference_threads"].as<int>();
+            auto n_instances = std::max(1, options["cpu_backends"].as<int>());
 
             if (n_threads <= 0)
             {
@@ -93,12 +119,12 @@ struct network_manager
                     torch::set_num_threads(2);
                 }
                 else {
-                    torch::set_num_threads(std::max(1u, n_threads/2));
+                    torch::set_num_threads(std::max(1u, n_threads/2/n_instances));
                 }
             }
             else torch::set_num_threads(n_threads);
 
-            add_backend(Network(weights_file, cpu_device, false));
+            add_cpu_backends(weights_file, n_instances);
         }
         else
         {
@@ -113,6 +139,8 @@ struct network_manager
             }
         }
 
+        set_stop_latency(std::chrono::milliseconds(options["stop_latency"].as<int>()));
+
     }
 
     ~network_manager()
@@ -123,7 +151,7 @@ struct network_manager
     }
 
 #ifndef SYNCHRONOUS_INFERENCE
-    void add_to_eval_queue(mcts::node *node_to_eval)
+    void add_to_eval_queue(mcts::batch_entry const& node_to_eval)
     {
         while (input_queue.size() >= max_input_queue_size)
             this_thread::sleep_for(1ms);
@@ -205,6 +233,18 @@ struct network_manager
 
     // If during tree traversal, a node that is enqueued but not yet processed is encountered, call this function to wait on it
     void wait_for_node_evaluation(const mcts::node* node_to_wait)
+    {
+        wait_for_evaluation([node_to_wait]() {
+            return node_to_wait->evaluated;
+        });
+    }
+
+    /*
+     * Waits until condition is true, it's checked under node_processed_lock whenever nodes have been evaluated.
+     * See mcts::traversal_scheduler for waiting on any of several nodes.
+     */
+    template<typename Condition>
+    void wait_for_evaluation(Condition condition)
     {
         //auto start = chrono::high_resolution_clock::now();
 
@@ -216,14 +256,12 @@ struct network_manager
 
         std::unique_lock lock(node_processed_lock);
 
-        if (!node_to_wait->evaluated)
+        if (!condition())
         {
 #ifndef SYNCHRONOUS_INFERENCE
             threads_waiting_for_output++;
 #endif
-            cv_node_processed.wait(lock, [&node_to_wait](){
-                return node_to_wait->evaluated;
-            });
+            cv_node_processed.wait(lock, condition);
 #ifndef SYNCHRONOUS_INFERENCE
             threads_waiting_for_output--;
 #endif
@@ -236,19 +274,90 @@ struct network_manager
 
     void add_backend(Network&& backend)
     {
-        backend->forward(torch::randn({32,112,8,8}, torch::TensorOptions()
-        .dtype(backend->expected_dtype).device(backend->device)));
+        auto input_options = torch::TensorOptions().dtype(backend->expected_dtype).device(backend->device);
+
+        if (batch_buckets.empty())
+            backend->forward(torch::randn({32,112,8,8}, input_options));
 
         std::cout << "info [netmgr] Adding backend " << backends.size() << std::endl;
+
+        // Every bucket's shape once to get its kernels picked, and once more to time it
+        if (!batch_buckets.empty())
+        {
+            std::cout << "info [netmgr] Warm-up latency by batch size:";
+
+            for (size_t bucket = 0; bucket < batch_buckets.size(); bucket++)
+            {
+                auto size = batch_buckets[bucket];
+                auto input = torch::randn({int64_t(size), NETWORK_INPUT_PLANES, 8, 8}, input_options);
+                backend->forward(input);
+
+                auto start = std::chrono::steady_clock::now();
+                backend->forward(input).value.to(cpu_device);
+
+                uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+                bucket_warmup_us[bucket] = std::max(bucket_warmup_us[bucket], us);
+
+                std::cout << " " << size << " " << us << "us";
+            }
+
+            std::cout << std::endl;
+        }
+
         backends.emplace_back(backend);
+    }
 
+    /*
+     * n_instances CPU backends sharing a single copy of the weights, see lc0::share_weights.
+     * Batches from different threads run on different instances at the same time.
+     *
+     * libtorch has one intra-op thread count for the whole process, so it's the same for every instance.
+     */
+    void add_cpu_backends(std::string const& weights_file, size_t n_instances)
+    {
+        Network weights(weights_file, cpu_device, false);
+
+        for (size_t i = 1; i < n_instances; i++)
+            add_backend(share_weights(weights));
+
+        add_backend(std::move(weights));
+    }
+
+    /*
+     * n_instances CPU backends per NUMA node. Every node's weights are loaded and warmed up by a thread pinned to it,
+     * so they're first touched, and placed, there. Threads use the backends of the node they run on.
+     * n_threads is per instance and defaults to half of a node's CPUs split between its instances.
+     */
+    void add_node_backends(std::string const& weights_file, int n_threads, size_t n_instances)
+    {
+        auto& topology = numa::get_topology();
+
+        if (n_threads <= 0)
+            n_threads = std::max<int>(1, topology.node_cpus[0].size() / 2 / n_instances);
+
+        torch::set_num_threads(n_threads);
+
+        for (size_t i = 0; i < topology.nodes(); i++)
+        {
+            std::thread([&]() {
+                numa::pin_to_node(int(i));
+                add_cpu_backends(weights_file, n_instances);
+            }).join();
+
+            backend_nodes.resize(backends.size(), int(i));
+        }
+    }
+
+    inline bool has_node_backends() const
+    {
+        return !backend_nodes.empty();
     }
 
     size_t autodetect_backends(std::string const& weights_file)
     {
         if (torch::cuda::is_available())
             for (int i = 0; i < torch::cuda::device_count(); i++)
-                backends.emplace_back(Network(weights_file, torch::Device(torch::kCUDA, i), true));
+                add_backend(Network(weights_file, torch::Device(torch::kCUDA, i), true));
         else
             add_backend(Network(weights_file, torch::Device(torch::DeviceType::CPU), false));
         return 1;
@@ -292,22 +401,282 @@ struct network_manager
     /*
      * Equivalent to input_processing -> inference -> output_processing, except it does everything on the calling thread
      */
-    void blocking_inference(std::vector<mcts::node*> const& batch)
+    void blocking_inference(std::vector<mcts::batch_entry> const& batch)
     {
         torch::InferenceMode inference_mode;
-        PositionHistory history;
+
+        // Higher priorities first, the whole batch shares a forward pass but nodes are finished one by one
+        thread_local std::vector<uint32_t> order;
+        order.resize(batch.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&batch](uint32_t a, uint32_t b) {
+            return batch[a].priority < batch[b].priority;
+        });
+
+        /*
+         * The moves of the leaves are generated now, the ones that don't need the network are done right away.
+         * Leaves only get their edges once the priors are known, so they can be limited to edge_limit.
+         */
+        thread_local mcts::batch_moves moves;
+        mcts::generate_leaf_moves(batch, moves);
+
+        size_t n_resolved = 0;
+
+        for (auto i : order)
+        {
+            if (!moves.needs_network[i])
+            {
+                finish_leaf(batch[i].node);
+                record_latency(batch[i]);
+                n_resolved++;
+            }
+        }
+
+        if (n_resolved == batch.size())
+            return;
+
+        // Entries for the network in order, chunk_rows at a time, a stop only has to wait for the chunk that's running
+        thread_local std::vector<uint32_t> pending;
+        pending.clear();
+
+        for (auto i : order)
+            if (moves.needs_network[i])
+                pending.push_back(i);
 
         auto temp_batch_data = (float(*)[NETWORK_INPUT_PLANES][8][8])memory_->get_batch_memory();
+        size_t n_dropped = 0;
+
+        for (size_t chunk_start = 0; chunk_start < pending.size();)
+        {
+            // Leaves that aren't evaluated yet are dropped, nodes that already have edges are still evaluated
+            if (stop_requested.load(std::memory_order_relaxed)) [[unlikely]]
+            {
+                auto kept = pending.begin() + chunk_start;
+
+                for (auto i = kept; i != pending.end(); i++)
+                {
+                    if (batch[*i].node->has_edges())
+                        *kept++ = *i;
+                    else
+                    {
+                        drop_leaf(batch[*i]);
+                        n_dropped++;
+                    }
+                }
+
+                pending.erase(kept, pending.end());
+            }
+
+            auto chunk_end = std::min(pending.size(), chunk_start + chunk_rows);
+
+            if (chunk_start < chunk_end)
+                n_resolved += evaluate_chunk(batch, moves, pending.data() + chunk_start, pending.data() + chunk_end,
+                                             temp_batch_data);
+
+            chunk_start = chunk_end;
+        }
+
+        nodes_processed += batch.size() - n_resolved - n_dropped;
+
+        memory_->release_batch_memory((float*)temp_batch_data);
+    }
+#endif
+
+
+    int get_max_batch_size() const
+    {
+        return max_batch_size;
+    }
+
+    /*
+     * Batches run in chunks of the largest bucket whose warm-up took at most half of latency, between chunks
+     * they check for a stop. 0 runs every batch at once. Without buckets there's nothing to go by, batches aren't split.
+     */
+    void set_stop_latency(std::chrono::milliseconds latency)
+    {
+        chunk_rows = max_batch_size;
+
+        if (latency.count() <= 0 || batch_buckets.empty())
+            return;
+
+        uint64_t budget_us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count() / 2;
+        chunk_rows = batch_buckets[0];
+
+        for (size_t i = 0; i < batch_buckets.size(); i++)
+            if (bucket_warmup_us[i] <= budget_us)
+                chunk_rows = batch_buckets[i];
+
+        std::cout << "info [netmgr] Batches run in chunks of up to " << chunk_rows << " for a stop latency of "
+                  << latency.count() << "ms" << std::endl;
+    }
+
+    // After a stop, leaves that haven't been evaluated yet are dropped instead, see blocking_inference
+    void request_stop()
+    {
+        stop_requested = true;
+    }
+
+    void clear_stop()
+    {
+        stop_requested = false;
+    }
+
+    inline bool is_stopping() const
+    {
+        return stop_requested.load(std::memory_order_relaxed);
+    }
+
+    // Time from entering a batch to being evaluated, by mcts::eval_priority
+    void report_latency(std::ostream& out)
+    {
+        const char* names[] = {"blocking", "normal", "filler"};
+
+        for (size_t i = 0; i < std::size(latency); i++)
+        {
+            auto nodes = latency[i].nodes.load(std::memory_order_relaxed);
+
+            if (nodes == 0)
+                continue;
+
+            out << "info [netmgr] " << names[i] << " nodes: " << nodes
+                << ", average latency " << latency[i].total_us.load(std::memory_order_relaxed) / nodes << "us"
+                << ", max " << latency[i].max_us.load(std::memory_order_relaxed) << "us" << std::endl;
+        }
+    }
+
+    void reset_latency()
+    {
+        for (auto& i : latency)
+        {
+            i.nodes = 0;
+            i.total_us = 0;
+            i.max_us = 0;
+        }
+    }
+
+    // Forward passes by bucket since the last reset, see batch_buckets
+    void report_bucket_latency(std::ostream& out)
+    {
+        for (size_t i = 0; i < batch_buckets.size(); i++)
+        {
+            auto batches = bucket_latency[i].batches.load(std::memory_order_relaxed);
+
+            if (batches == 0)
+                continue;
+
+            out << "info [netmgr] bucket " << batch_buckets[i] << ": " << batches << " batches, "
+                << 100 * bucket_latency[i].rows.load(std::memory_order_relaxed) / (batches * batch_buckets[i]) << "% filled, "
+                << bucket_latency[i].total_us.load(std::memory_order_relaxed) / batches << "us average, "
+                << bucket_latency[i].max_us.load(std::memory_order_relaxed) << "us max" << std::endl;
+        }
+    }
+
+    void reset_bucket_latency()
+    {
+        for (auto& i : bucket_latency)
+        {
+            i.batches = 0;
+            i.rows = 0;
+            i.total_us = 0;
+            i.max_us = 0;
+        }
+    }
+
+    // While enabled, the latency of every node is kept as well, for percentiles
+    void collect_latency_samples(bool enable)
+    {
+        std::lock_guard l(latency_samples_lock);
+        collecting_samples = enable;
+        latency_samples.clear();
+    }
+
+    std::vector<uint32_t> take_latency_samples()
+    {
+        std::lock_guard l(latency_samples_lock);
+        return std::exchange(latency_samples, {});
+    }
+private:
+
+    struct latency_stats
+    {
+        std::atomic<uint64_t> nodes = 0, total_us = 0, max_us = 0;
+    };
+
+    latency_stats latency[3];
+
+    /*
+     * Batches are padded up to the next of these sizes, powers of two and halfway between up to max_batch_size,
+     * so the backends only ever see a few shapes. Each is warmed up when a backend is added.
+     * Empty with --batch_buckets=false, batches then go in at their own size.
+     */
+    std::vector<size_t> batch_buckets;
+    std::vector<uint64_t> bucket_warmup_us; // Slowest backend's
+
+    size_t chunk_rows = 0;
+    std::atomic<bool> stop_requested = false;
+
+    struct bucket_stats
+    {
+        std::atomic<uint64_t> batches = 0, rows = 0, total_us = 0, max_us = 0;
+    };
+
+    // One per bucket, there are fewer than 64 of them
+    bucket_stats bucket_latency[64];
+
+    void record_bucket_latency(size_t bucket, size_t rows, std::chrono::steady_clock::time_point start)
+    {
+        auto& stats = bucket_latency[bucket];
+        uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        stats.batches.fetch_add(1, std::memory_order_relaxed);
+        stats.rows.fetch_add(rows, std::memory_order_relaxed);
+        stats.total_us.fetch_add(us, std::memory_order_relaxed);
+
+        auto max = stats.max_us.load(std::memory_order_relaxed);
+        while (us > max && !stats.max_us.compare_exchange_weak(max, us, std::memory_order_relaxed));
+    }
+
+    std::atomic<bool> collecting_samples = false;
+    std::vector<uint32_t> latency_samples;
+    std::mutex latency_samples_lock;
+
+    void record_latency(mcts::batch_entry const& entry)
+    {
+        auto& stats = latency[int(entry.priority)];
+        uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - entry.queued).count();
+
+        stats.nodes.fetch_add(1, std::memory_order_relaxed);
+        stats.total_us.fetch_add(us, std::memory_order_relaxed);
+
+        auto max = stats.max_us.load(std::memory_order_relaxed);
+        while (us > max && !stats.max_us.compare_exchange_weak(max, us, std::memory_order_relaxed));
+
+        if (collecting_samples.load(std::memory_order_relaxed)) [[unlikely]]
+        {
+            std::lock_guard l(latency_samples_lock);
+            latency_samples.push_back(uint32_t(std::min<uint64_t>(us, UINT32_MAX)));
+        }
+    }
+
+#ifdef SYNCHRONOUS_INFERENCE
+    /*
+     * Runs the entries from first to last (all of them need the network) through a single forward pass,
+     * returns how many of them couldn't be given their edges.
+     */
+    size_t evaluate_chunk(std::vector<mcts::batch_entry> const& batch, mcts::batch_moves const& moves,
+                          const uint32_t* first, const uint32_t* last, float (*temp_batch_data)[NETWORK_INPUT_PLANES][8][8])
+    {
+        PositionHistory history;
+        size_t n_resolved = 0;
 
-        int policy_indices[1024];
         int index_in_batch = 0;
 
-        for (auto node : batch)
+        for (auto entry_idx : std::span(first, last))
         {
-            for (; node && history.size() != 8; node = node->parent)
-                history.push_back(node->board);
+            auto& entry = batch[entry_idx];
 
-            reverse(history.begin(), history.end());
+            // Nodes don't store their positions, the worker that added the node copied them into the entry
+            history.assign(entry.history, entry.history + entry.history_size);
 
             int transform;
             auto planes = lczero::EncodePositionForNN(backends[0]->input_format, history, 8,
@@ -334,115 +703,170 @@ struct network_manager
 
 
 
-        auto batch_tensor = torch::from_blob(temp_batch_data, {index_in_batch, NETWORK_INPUT_PLANES, 8, 8}, torch::kFloat32)
+        // Padded with empty rows up to the next bucket, their outputs are never read
+        int64_t batch_rows = index_in_batch;
+        auto bucket = std::lower_bound(batch_buckets.begin(), batch_buckets.end(), size_t(index_in_batch));
+
+        if (bucket != batch_buckets.end())
+        {
+            batch_rows = int64_t(*bucket);
+            std::memset(temp_batch_data[index_in_batch], 0, (batch_rows - index_in_batch) * sizeof(temp_batch_data[0]));
+        }
+
+        auto forward_start = std::chrono::steady_clock::now();
+
+        auto batch_tensor = torch::from_blob(temp_batch_data, {batch_rows, NETWORK_INPUT_PLANES, 8, 8}, torch::kFloat32)
                 .to(net->device, net->expected_dtype);
 
         auto net_results = net->forward(batch_tensor);
 
 
         auto values_tensor = net_results.value.to(cpu_device, torch::Dtype::Float);
-        auto policy_tensor = net_results.policy.to(cpu_device, torch::Dtype::Float);
+        auto policy_tensor = net_results.policy.to(cpu_device, torch::Dtype::Float).contiguous();
         auto moves_left_tensor = net_results.moves_left.to(cpu_device, torch::Dtype::Float);
 
+        if (bucket != batch_buckets.end())
+            record_bucket_latency(bucket - batch_buckets.begin(), index_in_batch, forward_start);
 
         net->n_user_threads--;
 
 
         auto values = static_cast<float(*)[3]>(values_tensor.data_ptr());
         auto moves_left = static_cast<float*>(moves_left_tensor.data_ptr());
+        auto policy_data = static_cast<float*>(policy_tensor.data_ptr());
+        auto policy_stride = policy_tensor.size(1);
 
 
 
-        for (size_t i = 0; i < batch.size(); i++)
+        for (size_t i = 0; auto entry_idx : std::span(first, last))
         {
-            if (batch[i]->evaluated) continue;
-
-            // Q_ = L - W    To account for the perspective shift
-            float P_sum = 0, P_max = -std::numeric_limits<float>::infinity();
-
-            auto Q_ = values[i][2] - values[i][0];
+            // i is the row of the node in the network's output
+            auto row = i++;
+            auto node = batch[entry_idx].node;
 
+            //region Gather policy values
 
-            batch[i]->Q_ = Q_;
-            batch[i]->visits_pending = 0;
-            batch[i]->visit_count = 1;
-
-            if (batch[i]->parent)
-                batch[i]->parent->update_value(-Q_);
-
+            // Plain gather + softmax over the legal moves, in single precision before the priors are stored as halves
+            auto policy = policy_data + row * policy_stride;
+            float priors[256];
+            float P_sum = 0, P_max = -std::numeric_limits<float>::infinity();
 
-            int ml_temp = moves_left[i]; //net_results.moves_left[i].item<float>();
+            bool leaf = !node->has_edges();
+            size_t n_moves = leaf ? moves.count(entry_idx) : node->edge_count;
 
-            batch[i]->moves_left = ml_temp > 255 ? 255 : ml_temp;
+            for (size_t move_idx = 0; move_idx < n_moves; move_idx++)
+            {
+                auto move = leaf ? moves.begin(entry_idx)[move_idx] : node->get_edges()[move_idx].move;
+                priors[move_idx] = policy[node->flipped ? move.to_flipped_policy_index() : move.to_policy_index()];
+                P_max = std::max(P_max, priors[move_idx]);
+            }
 
-            //batch[i]->update_value(values[i][2] - values[i][0]);
+            for (size_t move_idx = 0; move_idx < n_moves; move_idx++)
+            {
+                priors[move_idx] = std::exp((priors[move_idx] - P_max) * softmax_temperature_reciprocal);
+                P_sum += priors[move_idx];
+            }
 
-            //region Gather policy values
+            float P_sum_reciprocal = P_sum > 0 ? 1 / P_sum : 0;
+            for (size_t move_idx = 0; move_idx < n_moves; move_idx++)
+                priors[move_idx] *= P_sum_reciprocal;
 
+            if (leaf)
+            {
+                // Comes out sorted, the visit is cancelled if there's no memory left for the edges
+                node = node->materialize(*memory_, moves.begin(entry_idx), n_moves, priors, edge_limit);
 
-            // Get node policy indices
-            if (batch[i]->board.flipped) {
-                for (int move_idx = 0; move_idx < batch[i]->edge_count; move_idx++)//(auto &child: *batch[i])
-                    policy_indices[move_idx] = batch[i]->begin()[move_idx].move.to_flipped_policy_index();
+                if (!node)
+                {
+                    finish_leaf(batch[entry_idx].node);
+                    record_latency(batch[entry_idx]);
+                    n_resolved++;
+                    continue;
+                }
             }
             else
             {
-                for (int move_idx = 0; move_idx < batch[i]->edge_count; move_idx++)//(auto &child: *batch[i])
-                    policy_indices[move_idx] = batch[i]->begin()[move_idx].move.to_policy_index();
-            }
-
-            // Create indices tensor and copy it to the relevant device
-            auto indices_tensor = torch::from_blob(policy_indices, {batch[i]->edge_count},
-                                                   c10::TensorOptions()
-                                                           .dtype(torch::kInt)).to(policy_tensor.device());
-
-            // Gather the policy values
-            auto gathered_p = torch::index_select(policy_tensor[i], 0, indices_tensor);
+                auto edges = node->get_edges();
+                for (size_t move_idx = 0; move_idx < n_moves; move_idx++)
+                    edges[move_idx].set_prior(priors[move_idx]);
 
-            auto pol_max = torch::max(gathered_p);
+                node->sort_edges_by_priors();
+            }
 
-            gathered_p = torch::exp((gathered_p - pol_max) * softmax_temperature_reciprocal);
+            //endregion
 
-            auto pol_sum = torch::sum(gathered_p);
+            // Q_ = L - W    To account for the perspective shift
+            auto Q_ = values[row][2] - values[row][0];
 
-            // Avoid any .item() calls as they appear to be very slow
-            //auto divisor = (pol_sum > 0) * pol_sum + (pol_sum <= 0) * 1;
 
-            float pol_sum_f = *(float*)pol_sum.data_ptr();
+            node->Q_ = Q_;
+            node->visits_pending = 0;
 
-            if (pol_sum_f > 0) gathered_p *= (1/ pol_sum);
-            //gathered_p *= (1/divisor);
+            // A speculative node only gets its first visit once a traversal selects it, see search::speculate
+            if (batch[entry_idx].priority == mcts::eval_priority::filler)
+            {
+                node->visit_count = 0;
+                node->parent->cancel_pending_visits();
+            }
+            else
+            {
+                node->visit_count = 1;
 
+                if (node->parent)
+                    node->parent->update_value(-Q_);
+            }
 
-            float* priors = static_cast<float*>(gathered_p.data_ptr());
 
+            int ml_temp = moves_left[row]; //net_results.moves_left[i].item<float>();
 
-            for (int move_idx = 0; move_idx < batch[i]->edge_count; move_idx++)
-                batch[i]->get_edges()[move_idx].set_prior(priors[move_idx]);
+            node->moves_left = ml_temp > 255 ? 255 : ml_temp;
 
-            batch[i]->sort_edges_by_priors();
+            //node->update_value(values[i][2] - values[i][0]);
 
-            std::lock_guard lock(node_processed_lock);
-            batch[i]->evaluated = true;
-            batch[i]->unlock();
+            {
+                std::lock_guard lock(node_processed_lock);
+                node->evaluated = true;
+                node->unlock();
 
+                // Threads that waited on the leaf before it moved
+                batch[entry_idx].node->evaluated = true;
+            }
 
             cv_node_processed.notify_all();
-        }
+            record_latency(batch[entry_idx]);
 
-        nodes_processed += batch.size();
+            if (leaf)
+                memory_->retire_leaf(batch[entry_idx].node);
+        }
 
-        memory_->release_batch_memory((float*)temp_batch_data);
+        return n_resolved;
+    }
 
+    // The leaf goes back to being an unexpanded edge, the threads waiting on it find the edge changed
+    void drop_leaf(mcts::batch_entry const& entry)
+    {
+        entry.node->roll_back();
+        finish_leaf(entry.node);
     }
 #endif
 
-
-    int get_max_batch_size() const
+    /*
+     * Wakes the threads waiting on a leaf that became terminal or couldn't be given edges, they find its edge changed.
+     * A bare leaf is dead after that and its header is recycled.
+     */
+    void finish_leaf(mcts::node* leaf)
     {
-        return max_batch_size;
+        bool was_evaluated;
+        {
+            std::lock_guard lock(node_processed_lock);
+            was_evaluated = leaf->evaluated;
+            leaf->evaluated = true;
+        }
+        cv_node_processed.notify_all();
+
+        if (!was_evaluated && !leaf->has_edges())
+            memory_->retire_leaf(leaf);
     }
-private:
 
 
     Network& get_backend()
@@ -452,12 +876,18 @@ private:
 
         static std::mutex sel_lock;
         std::lock_guard l_(sel_lock);
-        int best = 0;
-        int best_util = backends[0]->n_user_threads;
+        int best = -1;
+        int best_util = 0;
 
-        for (int i = 1; i < backends.size(); i++)
+        // With a backend per node, only the ones on the calling thread's node
+        int node = backend_nodes.empty() ? -1 : numa::current_node();
+
+        for (size_t i = 0; i < backends.size(); i++)
         {
-            if (backends[i]->n_user_threads < best_util)
+            if (node >= 0 && backend_nodes[i] != node)
+                continue;
+
+            if (best < 0 || backends[i]->n_user_threads < best_util)
             {
                 best_util = backends[i]->n_user_threads;
                 best = i;
@@ -474,8 +904,9 @@ private:
         torch::InferenceMode inference_mode;
 
         torch::Tensor batch_tensor;
-        std::vector<mcts::node*> temp_batch;
+        std::vector<mcts::batch_entry> temp_batch;
         temp_batch.reserve(max_batch_size);
+        std::vector<mcts::node*> nodes;
         PositionHistory history;
 
         auto temp_batch_data = static_cast<float(*)[112][8][8]>((void*)new float[NETWORK_INPUT_PLANES * max_batch_size * 8 * 8]);
@@ -499,34 +930,45 @@ private:
             });
 
 
-            // Gather batch from queue, also copy the nodes directly to the output_queue
+            // Gather batch from queue
             int batch_size = min(max_batch_size, input_queue.size());
 
-            output_queue_lock.lock();
             for (int i = 0; i < batch_size; i++)
             {
-                auto node = input_queue.front();
+                temp_batch.push_back(input_queue.front());
                 input_queue.pop();
-
-                temp_batch.push_back(node);
-                output_queue.push(node);
             }
 
-            output_queue_lock.unlock();
             queue_lock.unlock();
 
+            // Leaves get their edges, the ones that need the network go directly to the output_queue
+            nodes.resize(temp_batch.size());
+            mcts::materialize_leaves(temp_batch, *memory_, nodes.data());
+
+            output_queue_lock.lock();
+            for (size_t i = 0; i < temp_batch.size(); i++)
+            {
+                if (nodes[i])
+                    output_queue.push({nodes[i], temp_batch[i].node});
+                else
+                    finish_leaf(temp_batch[i].node);
+            }
+            output_queue_lock.unlock();
+
 
             //cout << "Collected batch of size: " << batch_size << endl;
 
             //batch_tensor = torch::zeros({batch_size, 112,8,8});
 
             // Preprocess nodes for the NN
-            for (auto& node : temp_batch)
+            for (size_t entry_idx = 0; entry_idx < temp_batch.size(); entry_idx++)
             {
-                for (; node && history.size() != 8; node = node->parent)
-                    history.push_back(node->board);
+                auto& entry = temp_batch[entry_idx];
+
+                if (!nodes[entry_idx])
+                    continue;
 
-                reverse(history.begin(), history.end());
+                history.assign(entry.history, entry.history + entry.history_size);
 
                 int transform;
                 auto planes = lczero::EncodePositionForNN(backends[0]->input_format, history, 8,
@@ -548,6 +990,12 @@ private:
                 history.clear();
             }
 
+            if (index_in_batch == 0)
+            {
+                temp_batch.clear();
+                continue;
+            }
+
             data_copy_lock.lock();
             batch_tensor = torch::from_blob(temp_batch_data, {index_in_batch, NETWORK_INPUT_PLANES, 8, 8}, torch::kFloat32)
             .to(backends[0]->device, backends[0]->expected_dtype);
@@ -574,6 +1022,9 @@ private:
         //torch::NoGradGuard guard;
         Network& network = backends[backend_idx];
 
+        if (!backend_nodes.empty())
+            numa::pin_to_node(backend_nodes[backend_idx]);
+
 
         std::unique_lock nn_input_lock(nn_input_batches_lock);
         nn_input_lock.unlock();
@@ -624,8 +1075,9 @@ private:
         torch::InferenceMode inference_mode;
 
         //torch::NoGradGuard grad_guard;
-        vector<mcts::node*> batch;
+        vector<mcts::node*> batch, leaves;
         batch.reserve(max_batch_size);
+        leaves.reserve(max_batch_size);
         float intermediate[1024];
 
         int* policy_indices = (int*)(intermediate);
@@ -663,7 +1115,8 @@ private:
             output_queue_lock.lock();
             for (size_t i = 0; i < batch_size; i++)
             {
-                batch.push_back(output_queue.front());
+                batch.push_back(output_queue.front().first);
+                leaves.push_back(output_queue.front().second);
                 output_queue.pop();
             }
             output_queue_lock.unlock();
@@ -713,15 +1166,8 @@ private:
 
 
                 // Get node policy indices
-                if (batch[i]->board.flipped) {
-                    for (int move_idx = 0; move_idx < batch[i]->edge_count; move_idx++)//(auto &child: *batch[i])
-                        policy_indices[move_idx] = batch[i]->begin()[move_idx].move.to_flipped_policy_index();
-                }
-                else
-                {
-                    for (int move_idx = 0; move_idx < batch[i]->edge_count; move_idx++)//(auto &child: *batch[i])
-                        policy_indices[move_idx] = batch[i]->begin()[move_idx].move.to_policy_index();
-                }
+                for (int move_idx = 0; move_idx < batch[i]->edge_count; move_idx++)
+                    policy_indices[move_idx] = batch[i]->get_edges()[move_idx].policy_index(batch[i]->flipped);
 
                 // Create indices tensor and copy it to the relevant device
                 auto indices_tensor = torch::from_blob(policy_indices, {batch[i]->edge_count},
@@ -760,9 +1206,7 @@ private:
                 {
                     auto& child = batch[i]->get_edges()[move_idx];
 
-                    auto policy_index = batch[i]->board.flipped ?
-                                        child.move.to_flipped_policy_index() :
-                                        child.move.to_policy_index();
+                    auto policy_index = child.policy_index;
 
                     //auto p = net_results.policy[i][policy_index].template item<float>();
                     auto p = policies[policy_index];
@@ -803,16 +1247,21 @@ private:
 
                 batch[i]->sort_edges_by_priors();
 
-                std::lock_guard lock(node_processed_lock);
-                batch[i]->evaluated = true;
-                batch[i]->unlock();
+                {
+                    std::lock_guard lock(node_processed_lock);
+                    batch[i]->evaluated = true;
+                    batch[i]->unlock();
 
+                    // Threads that waited on the leaf before it moved
+                    leaves[i]->evaluated = true;
+                }
 
                 cv_node_processed.notify_all();
             }
 
             nodes_processed += batch_size;
             batch.clear();
+            leaves.clear();
 
             //working_threads--;
             //endregion
@@ -821,6 +1270,9 @@ private:
 #endif
 
     float softmax_temperature, softmax_temperature_reciprocal;
+
+    // Newly evaluated nodes keep this many of their edges, see mcts::edge_limit
+    mcts::edge_limit edge_limit;
     size_t max_batch_size, min_batch_size, max_input_queue_size, max_nn_input_queue_size;
 
 #ifndef SYNCHRONOUS_INFERENCE
@@ -831,6 +1283,7 @@ private:
 #endif
 
     std::vector<Network> backends;
+    std::vector<int> backend_nodes; // NUMA node of every backend, empty unless there's one per node
 
     torch::Device cpu_device;
 
@@ -855,8 +1308,8 @@ private:
 
     std::queue<torch::Tensor> nn_input_batches;
     std::queue<lc0::NetworkOutput> nn_output_batches;
-    std::queue<mcts::node*> output_queue;
-    std::queue<mcts::node*> input_queue;
+    std::queue<std::pair<mcts::node*, mcts::node*>> output_queue; // Node to evaluate and the leaf it was moved from
+    std::queue<mcts::batch_entry> input_queue;
 #endif
 
 public:
@@ -0,0 +1,278 @@
+/*
+ * Maps a move, seen from the perspective of the player to move, to its index in the flattened 80x8x8 policy head.
+ *
+ * compact_policy_map[src][dst] covers every move except promotions to queen, rook or bishop,
+ * knight promotions share the index of the plain pawn move.
+ * compact_promotion_policy_map[src file][dst file - src file + 1][queen, rook, bishop] covers the rest,
+ * promotions always go from the 7th to the 8th rank after the board is oriented to the player to move.
+ */
+
+constexpr uint16_t compact_policy_map[64][64] = {
+        {0, 896, 960, 1024, 1088, 1152, 1216, 1280, 0, 448, 3648, 0, 0, 0, 0, 0,
+         64, 3584, 512, 0, 0, 0, 0, 0, 128, 0, 0, 576, 0, 0, 0, 0,
+         192, 0, 0, 0, 640, 0, 0, 0, 256, 0, 0, 0, 0, 704, 0, 0,
+         320, 0, 0, 0, 0, 0, 768, 0, 384, 0, 0, 0, 0, 0, 0, 832},
+        {2689, 0, 897, 961, 1025, 1089, 1153, 1217, 3137, 1, 449, 3649, 0, 0, 0, 0,
+         4033, 65, 3585, 513, 0, 0, 0, 0, 0, 129, 0, 0, 577, 0, 0, 0,
+         0, 193, 0, 0, 0, 641, 0, 0, 0, 257, 0, 0, 0, 0, 705, 0,
+         0, 321, 0, 0, 0, 0, 0, 769, 0, 385, 0, 0, 0, 0, 0, 0},
+        {2754, 2690, 0, 898, 962, 1026, 1090, 1154, 3970, 3138, 2, 450, 3650, 0, 0, 0,
+         3202, 4034, 66, 3586, 514, 0, 0, 0, 0, 0, 130, 0, 0, 578, 0, 0,
+         0, 0, 194, 0, 0, 0, 642, 0, 0, 0, 258, 0, 0, 0, 0, 706,
+         0, 0, 322, 0, 0, 0, 0, 0, 0, 0, 386, 0, 0, 0, 0, 0},
+        {2819, 2755, 2691, 0, 899, 963, 1027, 1091, 0, 3971, 3139, 3, 451, 3651, 0, 0,
+         0, 3203, 4035, 67, 3587, 515, 0, 0, 3267, 0, 0, 131, 0, 0, 579, 0,
+         0, 0, 0, 195, 0, 0, 0, 643, 0, 0, 0, 259, 0, 0, 0, 0,
+         0, 0, 0, 323, 0, 0, 0, 0, 0, 0, 0, 387, 0, 0, 0, 0},
+        {2884, 2820, 2756, 2692, 0, 900, 964, 1028, 0, 0, 3972, 3140, 4, 452, 3652, 0,
+         0, 0, 3204, 4036, 68, 3588, 516, 0, 0, 3268, 0, 0, 132, 0, 0, 580,
+         3332, 0, 0, 0, 196, 0, 0, 0, 0, 0, 0, 0, 260, 0, 0, 0,
+         0, 0, 0, 0, 324, 0, 0, 0, 0, 0, 0, 0, 388, 0, 0, 0},
+        {2949, 2885, 2821, 2757, 2693, 0, 901, 965, 0, 0, 0, 3973, 3141, 5, 453, 3653,
+         0, 0, 0, 3205, 4037, 69, 3589, 517, 0, 0, 3269, 0, 0, 133, 0, 0,
+         0, 3333, 0, 0, 0, 197, 0, 0, 3397, 0, 0, 0, 0, 261, 0, 0,
+         0, 0, 0, 0, 0, 325, 0, 0, 0, 0, 0, 0, 0, 389, 0, 0},
+        {3014, 2950, 2886, 2822, 2758, 2694, 0, 902, 0, 0, 0, 0, 3974, 3142, 6, 454,
+         0, 0, 0, 0, 3206, 4038, 70, 3590, 0, 0, 0, 3270, 0, 0, 134, 0,
+         0, 0, 3334, 0, 0, 0, 198, 0, 0, 3398, 0, 0, 0, 0, 262, 0,
+         3462, 0, 0, 0, 0, 0, 326, 0, 0, 0, 0, 0, 0, 0, 390, 0},
+        {3079, 3015, 2951, 2887, 2823, 2759, 2695, 0, 0, 0, 0, 0, 0, 3975, 3143, 7,
+         0, 0, 0, 0, 0, 3207, 4039, 71, 0, 0, 0, 0, 3271, 0, 0, 135,
+         0, 0, 0, 3335, 0, 0, 0, 199, 0, 0, 3399, 0, 0, 0, 0, 263,
+         0, 3463, 0, 0, 0, 0, 0, 327, 3527, 0, 0, 0, 0, 0, 0, 391},
+        {1800, 1352, 3720, 0, 0, 0, 0, 0, 0, 904, 968, 1032, 1096, 1160, 1224, 1288,
+         8, 456, 3656, 0, 0, 0, 0, 0, 72, 3592, 520, 0, 0, 0, 0, 0,
+         136, 0, 0, 584, 0, 0, 0, 0, 200, 0, 0, 0, 648, 0, 0, 0,
+         264, 0, 0, 0, 0, 712, 0, 0, 328, 0, 0, 0, 0, 0, 776, 0},
+        {2249, 1801, 1353, 3721, 0, 0, 0, 0, 2697, 0, 905, 969, 1033, 1097, 1161, 1225,
+         3145, 9, 457, 3657, 0, 0, 0, 0, 4041, 73, 3593, 521, 0, 0, 0, 0,
+         0, 137, 0, 0, 585, 0, 0, 0, 0, 201, 0, 0, 0, 649, 0, 0,
+         0, 265, 0, 0, 0, 0, 713, 0, 0, 329, 0, 0, 0, 0, 0, 777},
+        {3914, 2250, 1802, 1354, 3722, 0, 0, 0, 2762, 2698, 0, 906, 970, 1034, 1098, 1162,
+         3978, 3146, 10, 458, 3658, 0, 0, 0, 3210, 4042, 74, 3594, 522, 0, 0, 0,
+         0, 0, 138, 0, 0, 586, 0, 0, 0, 0, 202, 0, 0, 0, 650, 0,
+         0, 0, 266, 0, 0, 0, 0, 714, 0, 0, 330, 0, 0, 0, 0, 0},
+        {0, 3915, 2251, 1803, 1355, 3723, 0, 0, 2827, 2763, 2699, 0, 907, 971, 1035, 1099,
+         0, 3979, 3147, 11, 459, 3659, 0, 0, 0, 3211, 4043, 75, 3595, 523, 0, 0,
+         3275, 0, 0, 139, 0, 0, 587, 0, 0, 0, 0, 203, 0, 0, 0, 651,
+         0, 0, 0, 267, 0, 0, 0, 0, 0, 0, 0, 331, 0, 0, 0, 0},
+        {0, 0, 3916, 2252, 1804, 1356, 3724, 0, 2892, 2828, 2764, 2700, 0, 908, 972, 1036,
+         0, 0, 3980, 3148, 12, 460, 3660, 0, 0, 0, 3212, 4044, 76, 3596, 524, 0,
+         0, 3276, 0, 0, 140, 0, 0, 588, 3340, 0, 0, 0, 204, 0, 0, 0,
+         0, 0, 0, 0, 268, 0, 0, 0, 0, 0, 0, 0, 332, 0, 0, 0},
+        {0, 0, 0, 3917, 2253, 1805, 1357, 3725, 2957, 2893, 2829, 2765, 2701, 0, 909, 973,
+         0, 0, 0, 3981, 3149, 13, 461, 3661, 0, 0, 0, 3213, 4045, 77, 3597, 525,
+         0, 0, 3277, 0, 0, 141, 0, 0, 0, 3341, 0, 0, 0, 205, 0, 0,
+         3405, 0, 0, 0, 0, 269, 0, 0, 0, 0, 0, 0, 0, 333, 0, 0},
+        {0, 0, 0, 0, 3918, 2254, 1806, 1358, 3022, 2958, 2894, 2830, 2766, 2702, 0, 910,
+         0, 0, 0, 0, 3982, 3150, 14, 462, 0, 0, 0, 0, 3214, 4046, 78, 3598,
+         0, 0, 0, 3278, 0, 0, 142, 0, 0, 0, 3342, 0, 0, 0, 206, 0,
+         0, 3406, 0, 0, 0, 0, 270, 0, 3470, 0, 0, 0, 0, 0, 334, 0},
+        {0, 0, 0, 0, 0, 3919, 2255, 1807, 3087, 3023, 2959, 2895, 2831, 2767, 2703, 0,
+         0, 0, 0, 0, 0, 3983, 3151, 15, 0, 0, 0, 0, 0, 3215, 4047, 79,
+         0, 0, 0, 0, 3279, 0, 0, 143, 0, 0, 0, 3343, 0, 0, 0, 207,
+         0, 0, 3407, 0, 0, 0, 0, 271, 0, 3471, 0, 0, 0, 0, 0, 335},
+        {1872, 3792, 1424, 0, 0, 0, 0, 0, 1808, 1360, 3728, 0, 0, 0, 0, 0,
+         0, 912, 976, 1040, 1104, 1168, 1232, 1296, 16, 464, 3664, 0, 0, 0, 0, 0,
+         80, 3600, 528, 0, 0, 0, 0, 0, 144, 0, 0, 592, 0, 0, 0, 0,
+         208, 0, 0, 0, 656, 0, 0, 0, 272, 0, 0, 0, 0, 720, 0, 0},
+        {3857, 1873, 3793, 1425, 0, 0, 0, 0, 2257, 1809, 1361, 3729, 0, 0, 0, 0,
+         2705, 0, 913, 977, 1041, 1105, 1169, 1233, 3153, 17, 465, 3665, 0, 0, 0, 0,
+         4049, 81, 3601, 529, 0, 0, 0, 0, 0, 145, 0, 0, 593, 0, 0, 0,
+         0, 209, 0, 0, 0, 657, 0, 0, 0, 273, 0, 0, 0, 0, 721, 0},
+        {2322, 3858, 1874, 3794, 1426, 0, 0, 0, 3922, 2258, 1810, 1362, 3730, 0, 0, 0,
+         2770, 2706, 0, 914, 978, 1042, 1106, 1170, 3986, 3154, 18, 466, 3666, 0, 0, 0,
+         3218, 4050, 82, 3602, 530, 0, 0, 0, 0, 0, 146, 0, 0, 594, 0, 0,
+         0, 0, 210, 0, 0, 0, 658, 0, 0, 0, 274, 0, 0, 0, 0, 722},
+        {0, 2323, 3859, 1875, 3795, 1427, 0, 0, 0, 3923, 2259, 1811, 1363, 3731, 0, 0,
+         2835, 2771, 2707, 0, 915, 979, 1043, 1107, 0, 3987, 3155, 19, 467, 3667, 0, 0,
+         0, 3219, 4051, 83, 3603, 531, 0, 0, 3283, 0, 0, 147, 0, 0, 595, 0,
+         0, 0, 0, 211, 0, 0, 0, 659, 0, 0, 0, 275, 0, 0, 0, 0},
+        {0, 0, 2324, 3860, 1876, 3796, 1428, 0, 0, 0, 3924, 2260, 1812, 1364, 3732, 0,
+         2900, 2836, 2772, 2708, 0, 916, 980, 1044, 0, 0, 3988, 3156, 20, 468, 3668, 0,
+         0, 0, 3220, 4052, 84, 3604, 532, 0, 0, 3284, 0, 0, 148, 0, 0, 596,
+         3348, 0, 0, 0, 212, 0, 0, 0, 0, 0, 0, 0, 276, 0, 0, 0},
+        {0, 0, 0, 2325, 3861, 1877, 3797, 1429, 0, 0, 0, 3925, 2261, 1813, 1365, 3733,
+         2965, 2901, 2837, 2773, 2709, 0, 917, 981, 0, 0, 0, 3989, 3157, 21, 469, 3669,
+         0, 0, 0, 3221, 4053, 85, 3605, 533, 0, 0, 3285, 0, 0, 149, 0, 0,
+         0, 3349, 0, 0, 0, 213, 0, 0, 3413, 0, 0, 0, 0, 277, 0, 0},
+        {0, 0, 0, 0, 2326, 3862, 1878, 3798, 0, 0, 0, 0, 3926, 2262, 1814, 1366,
+         3030, 2966, 2902, 2838, 2774, 2710, 0, 918, 0, 0, 0, 0, 3990, 3158, 22, 470,
+         0, 0, 0, 0, 3222, 4054, 86, 3606, 0, 0, 0, 3286, 0, 0, 150, 0,
+         0, 0, 3350, 0, 0, 0, 214, 0, 0, 3414, 0, 0, 0, 0, 278, 0},
+        {0, 0, 0, 0, 0, 2327, 3863, 1879, 0, 0, 0, 0, 0, 3927, 2263, 1815,
+         3095, 3031, 2967, 2903, 2839, 2775, 2711, 0, 0, 0, 0, 0, 0, 3991, 3159, 23,
+         0, 0, 0, 0, 0, 3223, 4055, 87, 0, 0, 0, 0, 3287, 0, 0, 151,
+         0, 0, 0, 3351, 0, 0, 0, 215, 0, 0, 3415, 0, 0, 0, 0, 279},
+        {1944, 0, 0, 1496, 0, 0, 0, 0, 1880, 3800, 1432, 0, 0, 0, 0, 0,
+         1816, 1368, 3736, 0, 0, 0, 0, 0, 0, 920, 984, 1048, 1112, 1176, 1240, 1304,
+         24, 472, 3672, 0, 0, 0, 0, 0, 88, 3608, 536, 0, 0, 0, 0, 0,
+         152, 0, 0, 600, 0, 0, 0, 0, 216, 0, 0, 0, 664, 0, 0, 0},
+        {0, 1945, 0, 0, 1497, 0, 0, 0, 3865, 1881, 3801, 1433, 0, 0, 0, 0,
+         2265, 1817, 1369, 3737, 0, 0, 0, 0, 2713, 0, 921, 985, 1049, 1113, 1177, 1241,
+         3161, 25, 473, 3673, 0, 0, 0, 0, 4057, 89, 3609, 537, 0, 0, 0, 0,
+         0, 153, 0, 0, 601, 0, 0, 0, 0, 217, 0, 0, 0, 665, 0, 0},
+        {0, 0, 1946, 0, 0, 1498, 0, 0, 2330, 3866, 1882, 3802, 1434, 0, 0, 0,
+         3930, 2266, 1818, 1370, 3738, 0, 0, 0, 2778, 2714, 0, 922, 986, 1050, 1114, 1178,
+         3994, 3162, 26, 474, 3674, 0, 0, 0, 3226, 4058, 90, 3610, 538, 0, 0, 0,
+         0, 0, 154, 0, 0, 602, 0, 0, 0, 0, 218, 0, 0, 0, 666, 0},
+        {2395, 0, 0, 1947, 0, 0, 1499, 0, 0, 2331, 3867, 1883, 3803, 1435, 0, 0,
+         0, 3931, 2267, 1819, 1371, 3739, 0, 0, 2843, 2779, 2715, 0, 923, 987, 1051, 1115,
+         0, 3995, 3163, 27, 475, 3675, 0, 0, 0, 3227, 4059, 91, 3611, 539, 0, 0,
+         3291, 0, 0, 155, 0, 0, 603, 0, 0, 0, 0, 219, 0, 0, 0, 667},
+        {0, 2396, 0, 0, 1948, 0, 0, 1500, 0, 0, 2332, 3868, 1884, 3804, 1436, 0,
+         0, 0, 3932, 2268, 1820, 1372, 3740, 0, 2908, 2844, 2780, 2716, 0, 924, 988, 1052,
+         0, 0, 3996, 3164, 28, 476, 3676, 0, 0, 0, 3228, 4060, 92, 3612, 540, 0,
+         0, 3292, 0, 0, 156, 0, 0, 604, 3356, 0, 0, 0, 220, 0, 0, 0},
+        {0, 0, 2397, 0, 0, 1949, 0, 0, 0, 0, 0, 2333, 3869, 1885, 3805, 1437,
+         0, 0, 0, 3933, 2269, 1821, 1373, 3741, 2973, 2909, 2845, 2781, 2717, 0, 925, 989,
+         0, 0, 0, 3997, 3165, 29, 477, 3677, 0, 0, 0, 3229, 4061, 93, 3613, 541,
+         0, 0, 3293, 0, 0, 157, 0, 0, 0, 3357, 0, 0, 0, 221, 0, 0},
+        {0, 0, 0, 2398, 0, 0, 1950, 0, 0, 0, 0, 0, 2334, 3870, 1886, 3806,
+         0, 0, 0, 0, 3934, 2270, 1822, 1374, 3038, 2974, 2910, 2846, 2782, 2718, 0, 926,
+         0, 0, 0, 0, 3998, 3166, 30, 478, 0, 0, 0, 0, 3230, 4062, 94, 3614,
+         0, 0, 0, 3294, 0, 0, 158, 0, 0, 0, 3358, 0, 0, 0, 222, 0},
+        {0, 0, 0, 0, 2399, 0, 0, 1951, 0, 0, 0, 0, 0, 2335, 3871, 1887,
+         0, 0, 0, 0, 0, 3935, 2271, 1823, 3103, 3039, 2975, 2911, 2847, 2783, 2719, 0,
+         0, 0, 0, 0, 0, 3999, 3167, 31, 0, 0, 0, 0, 0, 3231, 4063, 95,
+         0, 0, 0, 0, 3295, 0, 0, 159, 0, 0, 0, 3359, 0, 0, 0, 223},
+        {2016, 0, 0, 0, 1568, 0, 0, 0, 1952, 0, 0, 1504, 0, 0, 0, 0,
+         1888, 3808, 1440, 0, 0, 0, 0, 0, 1824, 1376, 3744, 0, 0, 0, 0, 0,
+         0, 928, 992, 1056, 1120, 1184, 1248, 1312, 32, 480, 3680, 0, 0, 0, 0, 0,
+         96, 3616, 544, 0, 0, 0, 0, 0, 160, 0, 0, 608, 0, 0, 0, 0},
+        {0, 2017, 0, 0, 0, 1569, 0, 0, 0, 1953, 0, 0, 1505, 0, 0, 0,
+         3873, 1889, 3809, 1441, 0, 0, 0, 0, 2273, 1825, 1377, 3745, 0, 0, 0, 0,
+         2721, 0, 929, 993, 1057, 1121, 1185, 1249, 3169, 33, 481, 3681, 0, 0, 0, 0,
+         4065, 97, 3617, 545, 0, 0, 0, 0, 0, 161, 0, 0, 609, 0, 0, 0},
+        {0, 0, 2018, 0, 0, 0, 1570, 0, 0, 0, 1954, 0, 0, 1506, 0, 0,
+         2338, 3874, 1890, 3810, 1442, 0, 0, 0, 3938, 2274, 1826, 1378, 3746, 0, 0, 0,
+         2786, 2722, 0, 930, 994, 1058, 1122, 1186, 4002, 3170, 34, 482, 3682, 0, 0, 0,
+         3234, 4066, 98, 3618, 546, 0, 0, 0, 0, 0, 162, 0, 0, 610, 0, 0},
+        {0, 0, 0, 2019, 0, 0, 0, 1571, 2403, 0, 0, 1955, 0, 0, 1507, 0,
+         0, 2339, 3875, 1891, 3811, 1443, 0, 0, 0, 3939, 2275, 1827, 1379, 3747, 0, 0,
+         2851, 2787, 2723, 0, 931, 995, 1059, 1123, 0, 4003, 3171, 35, 483, 3683, 0, 0,
+         0, 3235, 4067, 99, 3619, 547, 0, 0, 3299, 0, 0, 163, 0, 0, 611, 0},
+        {2468, 0, 0, 0, 2020, 0, 0, 0, 0, 2404, 0, 0, 1956, 0, 0, 1508,
+         0, 0, 2340, 3876, 1892, 3812, 1444, 0, 0, 0, 3940, 2276, 1828, 1380, 3748, 0,
+         2916, 2852, 2788, 2724, 0, 932, 996, 1060, 0, 0, 4004, 3172, 36, 484, 3684, 0,
+         0, 0, 3236, 4068, 100, 3620, 548, 0, 0, 3300, 0, 0, 164, 0, 0, 612},
+        {0, 2469, 0, 0, 0, 2021, 0, 0, 0, 0, 2405, 0, 0, 1957, 0, 0,
+         0, 0, 0, 2341, 3877, 1893, 3813, 1445, 0, 0, 0, 3941, 2277, 1829, 1381, 3749,
+         2981, 2917, 2853, 2789, 2725, 0, 933, 997, 0, 0, 0, 4005, 3173, 37, 485, 3685,
+         0, 0, 0, 3237, 4069, 101, 3621, 549, 0, 0, 3301, 0, 0, 165, 0, 0},
+        {0, 0, 2470, 0, 0, 0, 2022, 0, 0, 0, 0, 2406, 0, 0, 1958, 0,
+         0, 0, 0, 0, 2342, 3878, 1894, 3814, 0, 0, 0, 0, 3942, 2278, 1830, 1382,
+         3046, 2982, 2918, 2854, 2790, 2726, 0, 934, 0, 0, 0, 0, 4006, 3174, 38, 486,
+         0, 0, 0, 0, 3238, 4070, 102, 3622, 0, 0, 0, 3302, 0, 0, 166, 0},
+        {0, 0, 0, 2471, 0, 0, 0, 2023, 0, 0, 0, 0, 2407, 0, 0, 1959,
+         0, 0, 0, 0, 0, 2343, 3879, 1895, 0, 0, 0, 0, 0, 3943, 2279, 1831,
+         3111, 3047, 2983, 2919, 2855, 2791, 2727, 0, 0, 0, 0, 0, 0, 4007, 3175, 39,
+         0, 0, 0, 0, 0, 3239, 4071, 103, 0, 0, 0, 0, 3303, 0, 0, 167},
+        {2088, 0, 0, 0, 0, 1640, 0, 0, 2024, 0, 0, 0, 1576, 0, 0, 0,
+         1960, 0, 0, 1512, 0, 0, 0, 0, 1896, 3816, 1448, 0, 0, 0, 0, 0,
+         1832, 1384, 3752, 0, 0, 0, 0, 0, 0, 936, 1000, 1064, 1128, 1192, 1256, 1320,
+         40, 488, 3688, 0, 0, 0, 0, 0, 104, 3624, 552, 0, 0, 0, 0, 0},
+        {0, 2089, 0, 0, 0, 0, 1641, 0, 0, 2025, 0, 0, 0, 1577, 0, 0,
+         0, 1961, 0, 0, 1513, 0, 0, 0, 3881, 1897, 3817, 1449, 0, 0, 0, 0,
+         2281, 1833, 1385, 3753, 0, 0, 0, 0, 2729, 0, 937, 1001, 1065, 1129, 1193, 1257,
+         3177, 41, 489, 3689, 0, 0, 0, 0, 4073, 105, 3625, 553, 0, 0, 0, 0},
+        {0, 0, 2090, 0, 0, 0, 0, 1642, 0, 0, 2026, 0, 0, 0, 1578, 0,
+         0, 0, 1962, 0, 0, 1514, 0, 0, 2346, 3882, 1898, 3818, 1450, 0, 0, 0,
+         3946, 2282, 1834, 1386, 3754, 0, 0, 0, 2794, 2730, 0, 938, 1002, 1066, 1130, 1194,
+         4010, 3178, 42, 490, 3690, 0, 0, 0, 3242, 4074, 106, 3626, 554, 0, 0, 0},
+        {0, 0, 0, 2091, 0, 0, 0, 0, 0, 0, 0, 2027, 0, 0, 0, 1579,
+         2411, 0, 0, 1963, 0, 0, 1515, 0, 0, 2347, 3883, 1899, 3819, 1451, 0, 0,
+         0, 3947, 2283, 1835, 1387, 3755, 0, 0, 2859, 2795, 2731, 0, 939, 1003, 1067, 1131,
+         0, 4011, 3179, 43, 491, 3691, 0, 0, 0, 3243, 4075, 107, 3627, 555, 0, 0},
+        {0, 0, 0, 0, 2092, 0, 0, 0, 2476, 0, 0, 0, 2028, 0, 0, 0,
+         0, 2412, 0, 0, 1964, 0, 0, 1516, 0, 0, 2348, 3884, 1900, 3820, 1452, 0,
+         0, 0, 3948, 2284, 1836, 1388, 3756, 0, 2924, 2860, 2796, 2732, 0, 940, 1004, 1068,
+         0, 0, 4012, 3180, 44, 492, 3692, 0, 0, 0, 3244, 4076, 108, 3628, 556, 0},
+        {2541, 0, 0, 0, 0, 2093, 0, 0, 0, 2477, 0, 0, 0, 2029, 0, 0,
+         0, 0, 2413, 0, 0, 1965, 0, 0, 0, 0, 0, 2349, 3885, 1901, 3821, 1453,
+         0, 0, 0, 3949, 2285, 1837, 1389, 3757, 2989, 2925, 2861, 2797, 2733, 0, 941, 1005,
+         0, 0, 0, 4013, 3181, 45, 493, 3693, 0, 0, 0, 3245, 4077, 109, 3629, 557},
+        {0, 2542, 0, 0, 0, 0, 2094, 0, 0, 0, 2478, 0, 0, 0, 2030, 0,
+         0, 0, 0, 2414, 0, 0, 1966, 0, 0, 0, 0, 0, 2350, 3886, 1902, 3822,
+         0, 0, 0, 0, 3950, 2286, 1838, 1390, 3054, 2990, 2926, 2862, 2798, 2734, 0, 942,
+         0, 0, 0, 0, 4014, 3182, 46, 494, 0, 0, 0, 0, 3246, 4078, 110, 3630},
+        {0, 0, 2543, 0, 0, 0, 0, 2095, 0, 0, 0, 2479, 0, 0, 0, 2031,
+         0, 0, 0, 0, 2415, 0, 0, 1967, 0, 0, 0, 0, 0, 2351, 3887, 1903,
+         0, 0, 0, 0, 0, 3951, 2287, 1839, 3119, 3055, 2991, 2927, 2863, 2799, 2735, 0,
+         0, 0, 0, 0, 0, 4015, 3183, 47, 0, 0, 0, 0, 0, 3247, 4079, 111},
+        {2160, 0, 0, 0, 0, 0, 1712, 0, 2096, 0, 0, 0, 0, 1648, 0, 0,
+         2032, 0, 0, 0, 1584, 0, 0, 0, 1968, 0, 0, 1520, 0, 0, 0, 0,
+         1904, 3824, 1456, 0, 0, 0, 0, 0, 1840, 1392, 3760, 0, 0, 0, 0, 0,
+         0, 944, 1008, 1072, 1136, 1200, 1264, 1328, 48, 496, 3696, 0, 0, 0, 0, 0},
+        {0, 2161, 0, 0, 0, 0, 0, 1713, 0, 2097, 0, 0, 0, 0, 1649, 0,
+         0, 2033, 0, 0, 0, 1585, 0, 0, 0, 1969, 0, 0, 1521, 0, 0, 0,
+         3889, 1905, 3825, 1457, 0, 0, 0, 0, 2289, 1841, 1393, 3761, 0, 0, 0, 0,
+         2737, 0, 945, 1009, 1073, 1137, 1201, 1265, 3185, 49, 497, 3697, 0, 0, 0, 0},
+        {0, 0, 2162, 0, 0, 0, 0, 0, 0, 0, 2098, 0, 0, 0, 0, 1650,
+         0, 0, 2034, 0, 0, 0, 1586, 0, 0, 0, 1970, 0, 0, 1522, 0, 0,
+         2354, 3890, 1906, 3826, 1458, 0, 0, 0, 3954, 2290, 1842, 1394, 3762, 0, 0, 0,
+         2802, 2738, 0, 946, 1010, 1074, 1138, 1202, 4018, 3186, 50, 498, 3698, 0, 0, 0},
+        {0, 0, 0, 2163, 0, 0, 0, 0, 0, 0, 0, 2099, 0, 0, 0, 0,
+         0, 0, 0, 2035, 0, 0, 0, 1587, 2419, 0, 0, 1971, 0, 0, 1523, 0,
+         0, 2355, 3891, 1907, 3827, 1459, 0, 0, 0, 3955, 2291, 1843, 1395, 3763, 0, 0,
+         2867, 2803, 2739, 0, 947, 1011, 1075, 1139, 0, 4019, 3187, 51, 499, 3699, 0, 0},
+        {0, 0, 0, 0, 2164, 0, 0, 0, 0, 0, 0, 0, 2100, 0, 0, 0,
+         2484, 0, 0, 0, 2036, 0, 0, 0, 0, 2420, 0, 0, 1972, 0, 0, 1524,
+         0, 0, 2356, 3892, 1908, 3828, 1460, 0, 0, 0, 3956, 2292, 1844, 1396, 3764, 0,
+         2932, 2868, 2804, 2740, 0, 948, 1012, 1076, 0, 0, 4020, 3188, 52, 500, 3700, 0},
+        {0, 0, 0, 0, 0, 2165, 0, 0, 2549, 0, 0, 0, 0, 2101, 0, 0,
+         0, 2485, 0, 0, 0, 2037, 0, 0, 0, 0, 2421, 0, 0, 1973, 0, 0,
+         0, 0, 0, 2357, 3893, 1909, 3829, 1461, 0, 0, 0, 3957, 2293, 1845, 1397, 3765,
+         2997, 2933, 2869, 2805, 2741, 0, 949, 1013, 0, 0, 0, 4021, 3189, 53, 501, 3701},
+        {2614, 0, 0, 0, 0, 0, 2166, 0, 0, 2550, 0, 0, 0, 0, 2102, 0,
+         0, 0, 2486, 0, 0, 0, 2038, 0, 0, 0, 0, 2422, 0, 0, 1974, 0,
+         0, 0, 0, 0, 2358, 3894, 1910, 3830, 0, 0, 0, 0, 3958, 2294, 1846, 1398,
+         3062, 2998, 2934, 2870, 2806, 2742, 0, 950, 0, 0, 0, 0, 4022, 3190, 54, 502},
+        {0, 2615, 0, 0, 0, 0, 0, 2167, 0, 0, 2551, 0, 0, 0, 0, 2103,
+         0, 0, 0, 2487, 0, 0, 0, 2039, 0, 0, 0, 0, 2423, 0, 0, 1975,
+         0, 0, 0, 0, 0, 2359, 3895, 1911, 0, 0, 0, 0, 0, 3959, 2295, 1847,
+         3127, 3063, 2999, 2935, 2871, 2807, 2743, 0, 0, 0, 0, 0, 0, 4023, 3191, 55},
+        {2232, 0, 0, 0, 0, 0, 0, 1784, 2168, 0, 0, 0, 0, 0, 1720, 0,
+         2104, 0, 0, 0, 0, 1656, 0, 0, 2040, 0, 0, 0, 1592, 0, 0, 0,
+         1976, 0, 0, 1528, 0, 0, 0, 0, 1912, 3832, 1464, 0, 0, 0, 0, 0,
+         1848, 1400, 3768, 0, 0, 0, 0, 0, 0, 952, 1016, 1080, 1144, 1208, 1272, 1336},
+        {0, 2233, 0, 0, 0, 0, 0, 0, 0, 2169, 0, 0, 0, 0, 0, 1721,
+         0, 2105, 0, 0, 0, 0, 1657, 0, 0, 2041, 0, 0, 0, 1593, 0, 0,
+         0, 1977, 0, 0, 1529, 0, 0, 0, 3897, 1913, 3833, 1465, 0, 0, 0, 0,
+         2297, 1849, 1401, 3769, 0, 0, 0, 0, 2745, 0, 953, 1017, 1081, 1145, 1209, 1273},
+        {0, 0, 2234, 0, 0, 0, 0, 0, 0, 0, 2170, 0, 0, 0, 0, 0,
+         0, 0, 2106, 0, 0, 0, 0, 1658, 0, 0, 2042, 0, 0, 0, 1594, 0,
+         0, 0, 1978, 0, 0, 1530, 0, 0, 2362, 3898, 1914, 3834, 1466, 0, 0, 0,
+         3962, 2298, 1850, 1402, 3770, 0, 0, 0, 2810, 2746, 0, 954, 1018, 1082, 1146, 1210},
+        {0, 0, 0, 2235, 0, 0, 0, 0, 0, 0, 0, 2171, 0, 0, 0, 0,
+         0, 0, 0, 2107, 0, 0, 0, 0, 0, 0, 0, 2043, 0, 0, 0, 1595,
+         2427, 0, 0, 1979, 0, 0, 1531, 0, 0, 2363, 3899, 1915, 3835, 1467, 0, 0,
+         0, 3963, 2299, 1851, 1403, 3771, 0, 0, 2875, 2811, 2747, 0, 955, 1019, 1083, 1147},
+        {0, 0, 0, 0, 2236, 0, 0, 0, 0, 0, 0, 0, 2172, 0, 0, 0,
+         0, 0, 0, 0, 2108, 0, 0, 0, 2492, 0, 0, 0, 2044, 0, 0, 0,
+         0, 2428, 0, 0, 1980, 0, 0, 1532, 0, 0, 2364, 3900, 1916, 3836, 1468, 0,
+         0, 0, 3964, 2300, 1852, 1404, 3772, 0, 2940, 2876, 2812, 2748, 0, 956, 1020, 1084},
+        {0, 0, 0, 0, 0, 2237, 0, 0, 0, 0, 0, 0, 0, 2173, 0, 0,
+         2557, 0, 0, 0, 0, 2109, 0, 0, 0, 2493, 0, 0, 0, 2045, 0, 0,
+         0, 0, 2429, 0, 0, 1981, 0, 0, 0, 0, 0, 2365, 3901, 1917, 3837, 1469,
+         0, 0, 0, 3965, 2301, 1853, 1405, 3773, 3005, 2941, 2877, 2813, 2749, 0, 957, 1021},
+        {0, 0, 0, 0, 0, 0, 2238, 0, 2622, 0, 0, 0, 0, 0, 2174, 0,
+         0, 2558, 0, 0, 0, 0, 2110, 0, 0, 0, 2494, 0, 0, 0, 2046, 0,
+         0, 0, 0, 2430, 0, 0, 1982, 0, 0, 0, 0, 0, 2366, 3902, 1918, 3838,
+         0, 0, 0, 0, 3966, 2302, 1854, 1406, 3070, 3006, 2942, 2878, 2814, 2750, 0, 958},
+        {2687, 0, 0, 0, 0, 0, 0, 2239, 0, 2623, 0, 0, 0, 0, 0, 2175,
+         0, 0, 2559, 0, 0, 0, 0, 2111, 0, 0, 0, 2495, 0, 0, 0, 2047,
+         0, 0, 0, 0, 2431, 0, 0, 1983, 0, 0, 0, 0, 0, 2367, 3903, 1919,
+         0, 0, 0, 0, 0, 3967, 2303, 1855, 3135, 3071, 3007, 2943, 2879, 2815, 2751, 0},
+};
+
+constexpr uint16_t compact_promotion_policy_map[8][3][3] = {
+        {{0, 0, 0}, {4464, 4336, 4400}, {4656, 4528, 4592}},
+        {{4273, 4145, 4209}, {4465, 4337, 4401}, {4657, 4529, 4593}},
+        {{4274, 4146, 4210}, {4466, 4338, 4402}, {4658, 4530, 4594}},
+        {{4275, 4147, 4211}, {4467, 4339, 4403}, {4659, 4531, 4595}},
+        {{4276, 4148, 4212}, {4468, 4340, 4404}, {4660, 4532, 4596}},
+        {{4277, 4149, 4213}, {4469, 4341, 4405}, {4661, 4533, 4597}},
+        {{4278, 4150, 4214}, {4470, 4342, 4406}, {4662, 4534, 4598}},
+        {{4279, 4151, 4215}, {4471, 4343, 4407}, {0, 0, 0}},
+};
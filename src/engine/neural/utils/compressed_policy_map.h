@@ -1,8197 +0,0 @@
-
-// compressed mapping, indexed by ((src | (dst << 6) | (promotion_mask << 12)) * 0x35456A24C7A57380) >> 51
-uint16_t policy_map[8191] = {
-        0,
-        1464,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3166,
-        0,
-        3825,
-        0,
-        0,
-        3332,
-        0,
-        0,
-        3991,
-        0,
-        0,
-        1898,
-        4465,
-        0,
-        0,
-        0,
-        0,
-        1168,
-        0,
-        0,
-        3875,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1097,
-        0,
-        0,
-        2332,
-        0,
-        0,
-        2095,
-        0,
-        1026,
-        0,
-        0,
-        0,
-        0,
-        205,
-        0,
-        3680,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        473,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        18,
-        0,
-        0,
-        1445,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3147,
-        0,
-        0,
-        3806,
-        0,
-        0,
-        0,
-        0,
-        3972,
-        0,
-        1852,
-        1879,
-        0,
-        3407,
-        0,
-        0,
-        0,
-        0,
-        2293,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3950,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3661,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3627,
-        454,
-        0,
-        3006,
-        0,
-        0,
-        0,
-        0,
-        100,
-        0,
-        0,
-        3063,
-        0,
-        1426,
-        0,
-        0,
-        2469,
-        4061,
-        0,
-        0,
-        1392,
-        0,
-        0,
-        643,
-        0,
-        4531,
-        3222,
-        0,
-        0,
-        1833,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2274,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        832,
-        0,
-        3931,
-        0,
-        0,
-        2030,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        268,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3608,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2430,
-        0,
-        81,
-        0,
-        0,
-        3748,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4042,
-        0,
-        0,
-        1373,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3203,
-        0,
-        0,
-        1814,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2740,
-        0,
-        2255,
-        3463,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2797,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2854,
-        0,
-        0,
-        0,
-        0,
-        0,
-        524,
-        0,
-        0,
-        2911,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3589,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2411,
-        163,
-        0,
-        0,
-        0,
-        3729,
-        0,
-        713,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1354,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3278,
-        0,
-        0,
-        2721,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2778,
-        0,
-        0,
-        1965,
-        0,
-        0,
-        0,
-        1208,
-        2835,
-        0,
-        331,
-        0,
-        0,
-        4403,
-        0,
-        1137,
-        0,
-        2892,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2162,
-        1066,
-        0,
-        2949,
-        0,
-        0,
-        0,
-        144,
-        0,
-        0,
-        995,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        924,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3187,
-        0,
-        2702,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4012,
-        0,
-        2759,
-        1919,
-        0,
-        1946,
-        594,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3701,
-        0,
-        976,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        494,
-        0,
-        905,
-        0,
-        0,
-        1500,
-        0,
-        0,
-        0,
-        39,
-        0,
-        0,
-        1466,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1312,
-        0,
-        3827,
-        0,
-        0,
-        3334,
-        0,
-        0,
-        1241,
-        0,
-        0,
-        1900,
-        4467,
-        0,
-        0,
-        0,
-        0,
-        1170,
-        0,
-        0,
-        3877,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1099,
-        0,
-        0,
-        2334,
-        0,
-        0,
-        2097,
-        0,
-        1028,
-        0,
-        0,
-        0,
-        0,
-        207,
-        0,
-        3682,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        475,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        20,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3149,
-        0,
-        0,
-        3808,
-        664,
-        0,
-        0,
-        3243,
-        3974,
-        0,
-        1854,
-        1881,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2295,
-        0,
-        3858,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3629,
-        456,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        102,
-        0,
-        1,
-        3769,
-        0,
-        1428,
-        0,
-        0,
-        2471,
-        4063,
-        0,
-        0,
-        1394,
-        0,
-        0,
-        0,
-        0,
-        4533,
-        0,
-        0,
-        0,
-        1835,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2276,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3933,
-        0,
-        0,
-        2032,
-        0,
-        0,
-        0,
-        2875,
-        0,
-        0,
-        270,
-        0,
-        0,
-        545,
-        0,
-        0,
-        2932,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3610,
-        0,
-        0,
-        2989,
-        0,
-        0,
-        0,
-        0,
-        83,
-        0,
-        0,
-        3046,
-        0,
-        0,
-        1593,
-        0,
-        0,
-        4044,
-        0,
-        0,
-        3103,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3205,
-        0,
-        0,
-        1816,
-        0,
-        0,
-        0,
-        3299,
-        0,
-        0,
-        2742,
-        0,
-        2257,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2799,
-        3914,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2413,
-        165,
-        0,
-        64,
-        1016,
-        3731,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        945,
-        1356,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2723,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2780,
-        0,
-        0,
-        1967,
-        0,
-        0,
-        0,
-        1210,
-        2837,
-        0,
-        333,
-        0,
-        0,
-        4405,
-        0,
-        1139,
-        0,
-        2894,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2164,
-        1068,
-        0,
-        2951,
-        0,
-        0,
-        0,
-        146,
-        0,
-        0,
-        997,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        926,
-        0,
-        0,
-        1521,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3189,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2550,
-        4014,
-        0,
-        0,
-        0,
-        0,
-        1948,
-        596,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3898,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1120,
-        0,
-        2355,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1049,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        978,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1720,
-        496,
-        0,
-        907,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        41,
-        0,
-        0,
-        1468,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3170,
-        0,
-        3829,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3995,
-        0,
-        0,
-        1902,
-        4469,
-        0,
-        577,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3879,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2099,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        209,
-        0,
-        3684,
-        0,
-        2687,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        477,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        22,
-        0,
-        0,
-        1449,
-        0,
-        0,
-        2492,
-        0,
-        0,
-        3151,
-        0,
-        0,
-        3810,
-        666,
-        0,
-        0,
-        3245,
-        1224,
-        0,
-        0,
-        1883,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1153,
-        2297,
-        0,
-        3860,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3954,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3665,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        458,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1648,
-        104,
-        0,
-        3,
-        3771,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4065,
-        0,
-        0,
-        1396,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3226,
-        0,
-        0,
-        1837,
-        0,
-        0,
-        0,
-        0,
-        4336,
-        0,
-        0,
-        2278,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3935,
-        0,
-        0,
-        2034,
-        0,
-        0,
-        0,
-        2877,
-        0,
-        0,
-        272,
-        0,
-        0,
-        547,
-        0,
-        0,
-        2934,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3612,
-        0,
-        0,
-        2991,
-        0,
-        0,
-        0,
-        0,
-        85,
-        0,
-        0,
-        3752,
-        0,
-        0,
-        1595,
-        0,
-        0,
-        4046,
-        0,
-        0,
-        1377,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3207,
-        0,
-        0,
-        1818,
-        0,
-        0,
-        0,
-        3301,
-        0,
-        0,
-        0,
-        0,
-        2259,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3916,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        528,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3593,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2415,
-        167,
-        0,
-        66,
-        1018,
-        3733,
-        0,
-        0,
-        1576,
-        0,
-        0,
-        0,
-        0,
-        947,
-        1358,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2725,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2782,
-        0,
-        0,
-        1969,
-        0,
-        0,
-        0,
-        0,
-        2839,
-        0,
-        335,
-        0,
-        0,
-        4407,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2166,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2396,
-        148,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        928,
-        0,
-        0,
-        1523,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3191,
-        0,
-        2706,
-        0,
-        0,
-        0,
-        3357,
-        0,
-        0,
-        1264,
-        0,
-        2763,
-        0,
-        0,
-        1950,
-        0,
-        0,
-        0,
-        1193,
-        0,
-        2820,
-        3900,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1122,
-        0,
-        2357,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1051,
-        0,
-        0,
-        0,
-        0,
-        0,
-        129,
-        0,
-        0,
-        980,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        498,
-        0,
-        909,
-        0,
-        0,
-        1504,
-        0,
-        0,
-        0,
-        43,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3172,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3997,
-        0,
-        0,
-        1904,
-        4471,
-        0,
-        579,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3881,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2338,
-        0,
-        2101,
-        0,
-        0,
-        1032,
-        0,
-        768,
-        0,
-        0,
-        211,
-        0,
-        0,
-        0,
-        961,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        24,
-        0,
-        0,
-        1451,
-        0,
-        0,
-        2494,
-        0,
-        0,
-        3153,
-        0,
-        0,
-        3812,
-        0,
-        0,
-        0,
-        3247,
-        3978,
-        0,
-        0,
-        1885,
-        3413,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2299,
-        0,
-        3862,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3956,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        192,
-        0,
-        0,
-        3667,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        460,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1650,
-        106,
-        0,
-        5,
-        3773,
-        0,
-        1432,
-        0,
-        0,
-        0,
-        4067,
-        0,
-        0,
-        1398,
-        0,
-        3793,
-        649,
-        0,
-        0,
-        3228,
-        0,
-        0,
-        1839,
-        0,
-        0,
-        0,
-        0,
-        4338,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2036,
-        0,
-        0,
-        0,
-        2879,
-        0,
-        0,
-        274,
-        0,
-        0,
-        549,
-        0,
-        3648,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3614,
-        2233,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        87,
-        0,
-        0,
-        3754,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1379,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1820,
-        0,
-        0,
-        0,
-        3303,
-        0,
-        0,
-        2746,
-        0,
-        2261,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2803,
-        3918,
-        0,
-        0,
-        2017,
-        0,
-        0,
-        0,
-        2860,
-        0,
-        0,
-        0,
-        0,
-        0,
-        530,
-        0,
-        0,
-        2917,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3595,
-        0,
-        0,
-        2974,
-        0,
-        0,
-        0,
-        0,
-        0,
-        68,
-        1020,
-        3031,
-        0,
-        0,
-        1578,
-        0,
-        0,
-        0,
-        949,
-        0,
-        1360,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1801,
-        0,
-        0,
-        0,
-        3284,
-        0,
-        0,
-        2727,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1971,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4210,
-        2168,
-        1072,
-        0,
-        0,
-        0,
-        0,
-        2398,
-        150,
-        0,
-        0,
-        1001,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        930,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2708,
-        0,
-        0,
-        0,
-        3359,
-        0,
-        0,
-        4018,
-        0,
-        2765,
-        0,
-        0,
-        1952,
-        600,
-        0,
-        0,
-        0,
-        0,
-        2822,
-        3902,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2359,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        131,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        500,
-        0,
-        0,
-        0,
-        0,
-        1506,
-        0,
-        0,
-        0,
-        45,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3174,
-        0,
-        2689,
-        3833,
-        0,
-        0,
-        3340,
-        0,
-        0,
-        3999,
-        0,
-        0,
-        1906,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1176,
-        0,
-        0,
-        3883,
-        4274,
-        0,
-        0,
-        0,
-        0,
-        1105,
-        0,
-        0,
-        2340,
-        0,
-        2103,
-        0,
-        0,
-        1034,
-        0,
-        0,
-        0,
-        0,
-        213,
-        0,
-        3688,
-        0,
-        963,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        481,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        26,
-        0,
-        0,
-        1453,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3155,
-        0,
-        0,
-        3814,
-        0,
-        0,
-        0,
-        0,
-        3980,
-        0,
-        0,
-        1887,
-        3415,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2301,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3958,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        194,
-        0,
-        0,
-        3669,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        462,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        108,
-        0,
-        7,
-        3071,
-        0,
-        1434,
-        0,
-        0,
-        2477,
-        4069,
-        0,
-        1280,
-        1400,
-        0,
-        3795,
-        651,
-        0,
-        0,
-        3230,
-        0,
-        0,
-        1841,
-        0,
-        0,
-        0,
-        0,
-        4340,
-        0,
-        0,
-        2282,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3939,
-        0,
-        0,
-        2038,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        276,
-        0,
-        0,
-        0,
-        0,
-        3650,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3616,
-        2235,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        89,
-        0,
-        0,
-        3756,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4050,
-        0,
-        0,
-        1381,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3211,
-        0,
-        0,
-        1822,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2748,
-        0,
-        2263,
-        3471,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2805,
-        0,
-        0,
-        0,
-        2019,
-        0,
-        0,
-        2614,
-        2862,
-        0,
-        0,
-        257,
-        0,
-        0,
-        532,
-        0,
-        0,
-        2919,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3597,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2419,
-        0,
-        0,
-        70,
-        0,
-        3737,
-        0,
-        721,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1362,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1803,
-        0,
-        0,
-        0,
-        3286,
-        0,
-        0,
-        2729,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2786,
-        0,
-        0,
-        1973,
-        0,
-        0,
-        0,
-        0,
-        2843,
-        0,
-        0,
-        0,
-        0,
-        0,
-        513,
-        1145,
-        0,
-        2900,
-        0,
-        0,
-        0,
-        0,
-        4212,
-        2170,
-        1074,
-        0,
-        2957,
-        0,
-        0,
-        0,
-        152,
-        0,
-        0,
-        1003,
-        0,
-        3014,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        932,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3267,
-        0,
-        0,
-        2710,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4020,
-        0,
-        2767,
-        3527,
-        0,
-        1954,
-        602,
-        0,
-        0,
-        0,
-        0,
-        0,
-        320,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        133,
-        0,
-        0,
-        984,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        502,
-        0,
-        913,
-        0,
-        0,
-        1508,
-        0,
-        0,
-        0,
-        47,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1320,
-        0,
-        2691,
-        3835,
-        0,
-        0,
-        3342,
-        0,
-        0,
-        1249,
-        0,
-        0,
-        1908,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1178,
-        0,
-        0,
-        3885,
-        4276,
-        0,
-        0,
-        0,
-        0,
-        1107,
-        0,
-        0,
-        2342,
-        0,
-        2105,
-        0,
-        0,
-        1036,
-        0,
-        0,
-        0,
-        0,
-        215,
-        0,
-        3690,
-        0,
-        965,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        483,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        28,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3157,
-        0,
-        3816,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3982,
-        0,
-        0,
-        1889,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2303,
-        0,
-        3866,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1088,
-        0,
-        0,
-        2323,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        196,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        464,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        110,
-        0,
-        9,
-        0,
-        0,
-        1436,
-        0,
-        0,
-        2479,
-        4071,
-        0,
-        3138,
-        1402,
-        0,
-        3797,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1843,
-        0,
-        0,
-        3398,
-        0,
-        4342,
-        0,
-        0,
-        2284,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3941,
-        0,
-        0,
-        2040,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        278,
-        0,
-        0,
-        553,
-        0,
-        3652,
-        2940,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3618,
-        2237,
-        0,
-        2997,
-        0,
-        0,
-        0,
-        0,
-        91,
-        0,
-        0,
-        3054,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4052,
-        0,
-        0,
-        3111,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3213,
-        0,
-        0,
-        1824,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2750,
-        2265,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2807,
-        3922,
-        0,
-        0,
-        2021,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        259,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2421,
-        0,
-        0,
-        72,
-        0,
-        3739,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4033,
-        953,
-        0,
-        1364,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1805,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2731,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2788,
-        0,
-        0,
-        1975,
-        0,
-        0,
-        0,
-        0,
-        2845,
-        0,
-        0,
-        0,
-        0,
-        0,
-        515,
-        1147,
-        0,
-        2902,
-        0,
-        0,
-        0,
-        0,
-        4214,
-        2172,
-        1076,
-        0,
-        2959,
-        0,
-        0,
-        0,
-        154,
-        0,
-        0,
-        1005,
-        0,
-        3720,
-        704,
-        0,
-        0,
-        0,
-        0,
-        0,
-        934,
-        0,
-        1529,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3269,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2558,
-        4022,
-        0,
-        0,
-        0,
-        0,
-        1956,
-        604,
-        4593,
-        0,
-        0,
-        0,
-        0,
-        322,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1128,
-        0,
-        2363,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1057,
-        0,
-        0,
-        0,
-        0,
-        0,
-        135,
-        0,
-        0,
-        986,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        915,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        49,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3178,
-        0,
-        2693,
-        3837,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4003,
-        0,
-        0,
-        1910,
-        0,
-        0,
-        585,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3887,
-        4278,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2107,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        217,
-        0,
-        0,
-        3692,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        485,
-        0,
-        896,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        30,
-        0,
-        0,
-        1457,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3159,
-        0,
-        3818,
-        4657,
-        0,
-        0,
-        0,
-        0,
-        1232,
-        0,
-        0,
-        1891,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1161,
-        385,
-        0,
-        3868,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1090,
-        3962,
-        0,
-        2325,
-        0,
-        0,
-        2088,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        198,
-        0,
-        0,
-        3673,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        466,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1656,
-        0,
-        0,
-        11,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4073,
-        0,
-        3140,
-        1404,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3234,
-        0,
-        0,
-        1845,
-        1872,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2286,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4145,
-        0,
-        0,
-        3943,
-        0,
-        0,
-        2042,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        555,
-        0,
-        0,
-        2942,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3620,
-        2239,
-        0,
-        2999,
-        0,
-        0,
-        0,
-        0,
-        93,
-        0,
-        0,
-        3760,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4054,
-        0,
-        0,
-        1385,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3215,
-        0,
-        0,
-        1826,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2267,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3924,
-        0,
-        0,
-        2023,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        261,
-        0,
-        0,
-        536,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3601,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2423,
-        0,
-        0,
-        74,
-        0,
-        3741,
-        0,
-        0,
-        1584,
-        0,
-        0,
-        4035,
-        955,
-        0,
-        1366,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1807,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2733,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2790,
-        0,
-        0,
-        1977,
-        0,
-        0,
-        0,
-        0,
-        2847,
-        0,
-        0,
-        0,
-        0,
-        0,
-        517,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2174,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2404,
-        156,
-        0,
-        0,
-        0,
-        0,
-        3722,
-        706,
-        0,
-        0,
-        0,
-        0,
-        0,
-        936,
-        0,
-        1531,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3271,
-        0,
-        0,
-        2714,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1272,
-        0,
-        2771,
-        0,
-        0,
-        1958,
-        0,
-        4595,
-        0,
-        1201,
-        2828,
-        0,
-        324,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1130,
-        2885,
-        2365,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1059,
-        0,
-        0,
-        0,
-        0,
-        0,
-        137,
-        0,
-        0,
-        988,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        917,
-        0,
-        0,
-        1512,
-        0,
-        0,
-        0,
-        51,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3180,
-        0,
-        2695,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2541,
-        4005,
-        0,
-        0,
-        1912,
-        0,
-        0,
-        587,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3889,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2346,
-        0,
-        2109,
-        0,
-        0,
-        1040,
-        0,
-        776,
-        0,
-        219,
-        0,
-        0,
-        0,
-        0,
-        969,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        898,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        32,
-        0,
-        0,
-        1459,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3161,
-        0,
-        3820,
-        4659,
-        0,
-        0,
-        0,
-        0,
-        3986,
-        0,
-        0,
-        1893,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        387,
-        0,
-        3870,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3964,
-        0,
-        2327,
-        0,
-        0,
-        2090,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        200,
-        0,
-        0,
-        3675,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        468,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1658,
-        0,
-        0,
-        13,
-        0,
-        0,
-        1440,
-        0,
-        0,
-        0,
-        4075,
-        0,
-        3142,
-        1406,
-        0,
-        3801,
-        657,
-        0,
-        0,
-        3236,
-        0,
-        0,
-        1847,
-        1874,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4147,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2044,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        557,
-        0,
-        3656,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3622,
-        449,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        95,
-        0,
-        0,
-        3762,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1387,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1828,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2269,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2811,
-        3926,
-        0,
-        0,
-        2025,
-        0,
-        0,
-        0,
-        2868,
-        0,
-        0,
-        263,
-        0,
-        0,
-        538,
-        0,
-        0,
-        2925,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3603,
-        0,
-        0,
-        2982,
-        0,
-        0,
-        0,
-        0,
-        76,
-        0,
-        0,
-        3039,
-        0,
-        0,
-        1586,
-        0,
-        0,
-        4037,
-        957,
-        0,
-        1368,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1809,
-        0,
-        0,
-        0,
-        3292,
-        0,
-        0,
-        2735,
-        0,
-        2250,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1979,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3584,
-        1080,
-        0,
-        0,
-        0,
-        0,
-        2406,
-        158,
-        0,
-        0,
-        1009,
-        0,
-        3724,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        938,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2716,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2773,
-        0,
-        0,
-        1960,
-        608,
-        4597,
-        0,
-        0,
-        2830,
-        0,
-        326,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2887,
-        2367,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        139,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1514,
-        0,
-        0,
-        0,
-        53,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3182,
-        0,
-        2697,
-        0,
-        0,
-        0,
-        3348,
-        0,
-        2543,
-        4007,
-        0,
-        2754,
-        1914,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1184,
-        0,
-        0,
-        3891,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1113,
-        0,
-        0,
-        2348,
-        0,
-        2111,
-        0,
-        0,
-        1042,
-        0,
-        0,
-        0,
-        221,
-        0,
-        0,
-        3696,
-        0,
-        971,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1713,
-        489,
-        0,
-        900,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        34,
-        0,
-        0,
-        1461,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3163,
-        0,
-        3822,
-        4661,
-        0,
-        0,
-        0,
-        0,
-        3988,
-        0,
-        0,
-        1895,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        389,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3966,
-        0,
-        0,
-        0,
-        0,
-        2092,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        202,
-        0,
-        3677,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        470,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        15,
-        0,
-        0,
-        1442,
-        0,
-        0,
-        2485,
-        4077,
-        0,
-        1288,
-        0,
-        0,
-        3803,
-        659,
-        0,
-        0,
-        3238,
-        1217,
-        0,
-        1849,
-        1876,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2290,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4149,
-        0,
-        0,
-        3947,
-        0,
-        0,
-        2046,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3658,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3624,
-        451,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1641,
-        97,
-        0,
-        0,
-        3764,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4058,
-        0,
-        0,
-        1389,
-        0,
-        0,
-        640,
-        0,
-        4528,
-        3219,
-        0,
-        0,
-        1830,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2271,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2813,
-        0,
-        0,
-        0,
-        0,
-        2027,
-        0,
-        0,
-        2622,
-        2870,
-        0,
-        0,
-        265,
-        0,
-        0,
-        540,
-        0,
-        0,
-        2927,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3605,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2427,
-        0,
-        78,
-        0,
-        0,
-        3745,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4039,
-        0,
-        0,
-        1370,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1811,
-        0,
-        0,
-        0,
-        3294,
-        0,
-        0,
-        2737,
-        0,
-        2252,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2794,
-        0,
-        0,
-        1981,
-        0,
-        0,
-        0,
-        0,
-        2851,
-        0,
-        0,
-        0,
-        0,
-        0,
-        521,
-        0,
-        0,
-        2908,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3586,
-        1082,
-        0,
-        2965,
-        0,
-        0,
-        0,
-        160,
-        0,
-        0,
-        1011,
-        0,
-        3022,
-        0,
-        1569,
-        0,
-        0,
-        0,
-        0,
-        940,
-        3079,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3275,
-        0,
-        0,
-        2718,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2775,
-        0,
-        0,
-        1962,
-        610,
-        0,
-        0,
-        0,
-        0,
-        0,
-        328,
-        0,
-        0,
-        4400,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        141,
-        0,
-        0,
-        992,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        921,
-        0,
-        0,
-        1516,
-        0,
-        0,
-        0,
-        55,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1328,
-        0,
-        2699,
-        0,
-        0,
-        0,
-        3350,
-        0,
-        0,
-        1257,
-        0,
-        2756,
-        1916,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1186,
-        0,
-        0,
-        3893,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1115,
-        0,
-        0,
-        2350,
-        0,
-        0,
-        0,
-        0,
-        1044,
-        0,
-        0,
-        0,
-        223,
-        0,
-        0,
-        3698,
-        0,
-        973,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        491,
-        0,
-        902,
-        0,
-        0,
-        1497,
-        0,
-        0,
-        0,
-        36,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3165,
-        0,
-        3824,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3990,
-        0,
-        0,
-        1897,
-        4464,
-        0,
-        0,
-        0,
-        0,
-        0,
-        391,
-        0,
-        3874,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1096,
-        0,
-        0,
-        2331,
-        0,
-        0,
-        2094,
-        0,
-        1025,
-        0,
-        0,
-        0,
-        0,
-        204,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        472,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        17,
-        0,
-        0,
-        1444,
-        0,
-        0,
-        2487,
-        4079,
-        0,
-        3146,
-        0,
-        0,
-        3805,
-        0,
-        0,
-        0,
-        0,
-        3971,
-        0,
-        1851,
-        1878,
-        0,
-        3406,
-        0,
-        0,
-        0,
-        0,
-        2292,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4151,
-        0,
-        0,
-        3949,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3660,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3626,
-        453,
-        0,
-        3005,
-        0,
-        0,
-        0,
-        0,
-        99,
-        0,
-        0,
-        3062,
-        0,
-        1425,
-        0,
-        0,
-        2468,
-        4060,
-        0,
-        0,
-        3119,
-        0,
-        0,
-        642,
-        0,
-        4530,
-        3221,
-        0,
-        0,
-        1832,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2273,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2815,
-        0,
-        3930,
-        0,
-        0,
-        2029,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        267,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2429,
-        0,
-        80,
-        0,
-        0,
-        3747,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4041,
-        0,
-        0,
-        1372,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3202,
-        0,
-        0,
-        1813,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2739,
-        0,
-        2254,
-        3462,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2796,
-        0,
-        0,
-        1983,
-        0,
-        0,
-        0,
-        0,
-        2853,
-        0,
-        0,
-        0,
-        0,
-        0,
-        523,
-        0,
-        0,
-        2910,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3588,
-        1084,
-        0,
-        2967,
-        0,
-        0,
-        0,
-        162,
-        0,
-        0,
-        1013,
-        3728,
-        0,
-        712,
-        1571,
-        0,
-        0,
-        0,
-        0,
-        942,
-        1353,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3277,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1964,
-        612,
-        0,
-        0,
-        0,
-        0,
-        0,
-        330,
-        0,
-        0,
-        4402,
-        0,
-        1136,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2161,
-        1065,
-        0,
-        0,
-        0,
-        0,
-        0,
-        143,
-        0,
-        0,
-        994,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        923,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3186,
-        0,
-        2701,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4011,
-        0,
-        2758,
-        1918,
-        0,
-        1945,
-        593,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3895,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3700,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        493,
-        0,
-        904,
-        0,
-        0,
-        1499,
-        0,
-        0,
-        0,
-        38,
-        0,
-        0,
-        1465,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3167,
-        0,
-        3826,
-        0,
-        0,
-        3333,
-        0,
-        0,
-        1240,
-        0,
-        0,
-        1899,
-        4466,
-        0,
-        0,
-        0,
-        0,
-        1169,
-        0,
-        0,
-        3876,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1098,
-        0,
-        0,
-        2333,
-        0,
-        0,
-        2096,
-        0,
-        1027,
-        0,
-        0,
-        0,
-        0,
-        206,
-        0,
-        3681,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        474,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        19,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3148,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3242,
-        3973,
-        0,
-        1853,
-        1880,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2294,
-        0,
-        3857,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3951,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3628,
-        0,
-        0,
-        3007,
-        0,
-        0,
-        0,
-        0,
-        101,
-        0,
-        0,
-        3768,
-        0,
-        1427,
-        0,
-        0,
-        2470,
-        4062,
-        0,
-        0,
-        1393,
-        0,
-        0,
-        0,
-        0,
-        4532,
-        3223,
-        0,
-        0,
-        1834,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2275,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3932,
-        0,
-        0,
-        2031,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        269,
-        0,
-        0,
-        544,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3609,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2431,
-        0,
-        82,
-        0,
-        0,
-        3749,
-        0,
-        0,
-        1592,
-        0,
-        0,
-        4043,
-        0,
-        0,
-        1374,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3204,
-        0,
-        0,
-        1815,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2741,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2798,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2855,
-        0,
-        0,
-        0,
-        0,
-        0,
-        525,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3590,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2412,
-        164,
-        0,
-        0,
-        0,
-        3730,
-        0,
-        714,
-        0,
-        0,
-        0,
-        0,
-        0,
-        944,
-        1355,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3279,
-        0,
-        0,
-        2722,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2779,
-        0,
-        0,
-        1966,
-        0,
-        0,
-        0,
-        1209,
-        2836,
-        0,
-        332,
-        0,
-        0,
-        4404,
-        0,
-        1138,
-        0,
-        2893,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2163,
-        1067,
-        0,
-        2950,
-        0,
-        0,
-        0,
-        145,
-        0,
-        0,
-        996,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        925,
-        0,
-        0,
-        1520,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3188,
-        0,
-        2703,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2549,
-        4013,
-        0,
-        0,
-        0,
-        0,
-        1947,
-        595,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3897,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2354,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1048,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        977,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        906,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        40,
-        0,
-        0,
-        1467,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3169,
-        0,
-        3828,
-        0,
-        0,
-        3335,
-        0,
-        0,
-        3994,
-        0,
-        0,
-        1901,
-        4468,
-        0,
-        576,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3878,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2335,
-        0,
-        0,
-        2098,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        208,
-        0,
-        3683,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        476,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        21,
-        0,
-        0,
-        1448,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3150,
-        0,
-        0,
-        3809,
-        665,
-        0,
-        0,
-        3244,
-        3975,
-        0,
-        1855,
-        1882,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1152,
-        0,
-        0,
-        3859,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3664,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3630,
-        457,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        103,
-        0,
-        2,
-        3770,
-        0,
-        1429,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1395,
-        0,
-        0,
-        0,
-        0,
-        4534,
-        0,
-        0,
-        0,
-        1836,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2277,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3934,
-        0,
-        0,
-        2033,
-        0,
-        0,
-        0,
-        2876,
-        0,
-        0,
-        271,
-        0,
-        0,
-        546,
-        0,
-        0,
-        2933,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3611,
-        0,
-        0,
-        2990,
-        0,
-        0,
-        0,
-        0,
-        84,
-        0,
-        0,
-        3047,
-        0,
-        0,
-        1594,
-        0,
-        0,
-        4045,
-        0,
-        0,
-        1376,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3206,
-        0,
-        0,
-        1817,
-        0,
-        0,
-        0,
-        3300,
-        0,
-        0,
-        2743,
-        0,
-        2258,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3915,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3592,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2414,
-        166,
-        0,
-        65,
-        1017,
-        3732,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        946,
-        1357,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2724,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2781,
-        0,
-        0,
-        1968,
-        0,
-        0,
-        0,
-        0,
-        2838,
-        0,
-        334,
-        0,
-        0,
-        4406,
-        0,
-        0,
-        0,
-        2895,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2165,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2395,
-        147,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1522,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3190,
-        0,
-        2705,
-        0,
-        0,
-        0,
-        3356,
-        0,
-        2551,
-        4015,
-        0,
-        2762,
-        0,
-        0,
-        1949,
-        0,
-        0,
-        0,
-        1192,
-        0,
-        2819,
-        3899,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1121,
-        0,
-        2356,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1050,
-        0,
-        0,
-        0,
-        0,
-        0,
-        128,
-        0,
-        0,
-        979,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1721,
-        497,
-        0,
-        908,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        42,
-        0,
-        0,
-        1469,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3171,
-        0,
-        3830,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3996,
-        0,
-        0,
-        1903,
-        4470,
-        0,
-        578,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2100,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        210,
-        0,
-        3685,
-        0,
-        960,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        478,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        23,
-        0,
-        0,
-        1450,
-        0,
-        0,
-        2493,
-        0,
-        0,
-        1296,
-        0,
-        0,
-        3811,
-        667,
-        0,
-        0,
-        3246,
-        1225,
-        0,
-        0,
-        1884,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1154,
-        2298,
-        0,
-        3861,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3955,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3666,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        459,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1649,
-        105,
-        0,
-        4,
-        3772,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4066,
-        0,
-        0,
-        1397,
-        0,
-        3792,
-        648,
-        0,
-        0,
-        3227,
-        0,
-        0,
-        1838,
-        0,
-        0,
-        0,
-        0,
-        4337,
-        0,
-        0,
-        2279,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2035,
-        0,
-        0,
-        0,
-        2878,
-        0,
-        0,
-        273,
-        0,
-        0,
-        548,
-        0,
-        0,
-        2935,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3613,
-        2232,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        86,
-        0,
-        0,
-        3753,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4047,
-        0,
-        0,
-        1378,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1819,
-        0,
-        0,
-        0,
-        3302,
-        0,
-        0,
-        2745,
-        0,
-        2260,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2802,
-        3917,
-        0,
-        0,
-        2016,
-        0,
-        0,
-        0,
-        2859,
-        0,
-        0,
-        0,
-        0,
-        0,
-        529,
-        0,
-        0,
-        2916,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3594,
-        0,
-        0,
-        2973,
-        0,
-        0,
-        0,
-        0,
-        0,
-        67,
-        1019,
-        3030,
-        0,
-        0,
-        1577,
-        0,
-        0,
-        0,
-        948,
-        0,
-        3087,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1800,
-        0,
-        0,
-        0,
-        3283,
-        0,
-        0,
-        2726,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2783,
-        0,
-        0,
-        1970,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4209,
-        2167,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2397,
-        149,
-        0,
-        0,
-        1000,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        929,
-        0,
-        0,
-        1524,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1336,
-        0,
-        2707,
-        0,
-        0,
-        0,
-        3358,
-        0,
-        0,
-        1265,
-        0,
-        2764,
-        0,
-        0,
-        1951,
-        0,
-        0,
-        0,
-        1194,
-        0,
-        2821,
-        3901,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1123,
-        0,
-        2358,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1052,
-        0,
-        0,
-        0,
-        0,
-        0,
-        130,
-        0,
-        0,
-        981,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        499,
-        0,
-        910,
-        0,
-        0,
-        1505,
-        0,
-        0,
-        0,
-        44,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3173,
-        0,
-        0,
-        3832,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3998,
-        0,
-        0,
-        1905,
-        0,
-        0,
-        580,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3882,
-        4273,
-        0,
-        0,
-        0,
-        0,
-        1104,
-        0,
-        0,
-        2339,
-        0,
-        2102,
-        0,
-        0,
-        1033,
-        0,
-        769,
-        0,
-        0,
-        212,
-        0,
-        0,
-        0,
-        962,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        480,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        25,
-        0,
-        0,
-        1452,
-        0,
-        0,
-        2495,
-        0,
-        0,
-        3154,
-        0,
-        0,
-        3813,
-        0,
-        0,
-        0,
-        0,
-        3979,
-        0,
-        0,
-        1886,
-        3414,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2300,
-        0,
-        3863,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3957,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        193,
-        0,
-        0,
-        3668,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        461,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        107,
-        0,
-        6,
-        3070,
-        0,
-        1433,
-        0,
-        0,
-        2476,
-        4068,
-        0,
-        0,
-        3127,
-        0,
-        3794,
-        650,
-        0,
-        0,
-        3229,
-        0,
-        0,
-        1840,
-        0,
-        0,
-        0,
-        0,
-        4339,
-        0,
-        0,
-        2281,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3938,
-        0,
-        0,
-        2037,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        275,
-        0,
-        0,
-        0,
-        0,
-        3649,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2234,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        88,
-        0,
-        0,
-        3755,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4049,
-        0,
-        0,
-        1380,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3210,
-        0,
-        0,
-        1821,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2747,
-        0,
-        2262,
-        3470,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2804,
-        3919,
-        0,
-        0,
-        2018,
-        0,
-        0,
-        0,
-        2861,
-        0,
-        0,
-        256,
-        0,
-        0,
-        531,
-        0,
-        0,
-        2918,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3596,
-        0,
-        0,
-        2975,
-        0,
-        0,
-        0,
-        0,
-        0,
-        69,
-        1021,
-        3736,
-        0,
-        720,
-        1579,
-        0,
-        0,
-        0,
-        950,
-        0,
-        1361,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1802,
-        0,
-        0,
-        0,
-        3285,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1972,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        512,
-        1144,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4211,
-        2169,
-        1073,
-        0,
-        0,
-        0,
-        0,
-        2399,
-        151,
-        0,
-        0,
-        1002,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        931,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2709,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4019,
-        0,
-        2766,
-        0,
-        0,
-        1953,
-        601,
-        0,
-        0,
-        0,
-        0,
-        2823,
-        3903,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        132,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        501,
-        0,
-        912,
-        0,
-        0,
-        1507,
-        0,
-        0,
-        0,
-        46,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3175,
-        0,
-        2690,
-        3834,
-        0,
-        0,
-        3341,
-        0,
-        0,
-        1248,
-        0,
-        0,
-        1907,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1177,
-        0,
-        0,
-        3884,
-        4275,
-        0,
-        0,
-        0,
-        0,
-        1106,
-        0,
-        0,
-        2341,
-        0,
-        2104,
-        0,
-        0,
-        1035,
-        0,
-        0,
-        0,
-        0,
-        214,
-        0,
-        3689,
-        0,
-        964,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        482,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        27,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3156,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3981,
-        0,
-        0,
-        1888,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2302,
-        0,
-        3865,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3959,
-        0,
-        2322,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        195,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        109,
-        0,
-        8,
-        0,
-        0,
-        1435,
-        0,
-        0,
-        2478,
-        4070,
-        0,
-        3137,
-        1401,
-        0,
-        3796,
-        0,
-        0,
-        0,
-        3231,
-        0,
-        0,
-        1842,
-        0,
-        0,
-        3397,
-        0,
-        4341,
-        0,
-        0,
-        2283,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3940,
-        0,
-        0,
-        2039,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        277,
-        0,
-        0,
-        552,
-        0,
-        3651,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3617,
-        2236,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        90,
-        0,
-        0,
-        3757,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4051,
-        0,
-        0,
-        1382,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3212,
-        0,
-        0,
-        1823,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2749,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2806,
-        0,
-        0,
-        0,
-        2020,
-        0,
-        0,
-        2615,
-        2863,
-        0,
-        0,
-        258,
-        0,
-        0,
-        533,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3598,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2420,
-        0,
-        0,
-        71,
-        0,
-        3738,
-        0,
-        722,
-        0,
-        0,
-        0,
-        0,
-        952,
-        0,
-        1363,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1804,
-        0,
-        0,
-        0,
-        3287,
-        0,
-        0,
-        2730,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2787,
-        0,
-        0,
-        1974,
-        0,
-        0,
-        0,
-        0,
-        2844,
-        0,
-        0,
-        0,
-        0,
-        0,
-        514,
-        1146,
-        0,
-        2901,
-        0,
-        0,
-        0,
-        0,
-        4213,
-        2171,
-        1075,
-        0,
-        2958,
-        0,
-        0,
-        0,
-        153,
-        0,
-        0,
-        1004,
-        0,
-        3015,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        933,
-        0,
-        1528,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3268,
-        0,
-        0,
-        2711,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2557,
-        4021,
-        0,
-        0,
-        0,
-        0,
-        1955,
-        603,
-        4592,
-        0,
-        0,
-        0,
-        0,
-        321,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2362,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1056,
-        0,
-        0,
-        0,
-        0,
-        0,
-        134,
-        0,
-        0,
-        985,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        914,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        48,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3177,
-        0,
-        2692,
-        3836,
-        0,
-        0,
-        3343,
-        0,
-        0,
-        4002,
-        0,
-        0,
-        1909,
-        0,
-        0,
-        584,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3886,
-        4277,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2343,
-        0,
-        2106,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        216,
-        0,
-        0,
-        3691,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        484,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        29,
-        0,
-        0,
-        1456,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3158,
-        0,
-        3817,
-        4656,
-        0,
-        0,
-        0,
-        0,
-        3983,
-        0,
-        0,
-        1890,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1160,
-        384,
-        0,
-        3867,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1089,
-        0,
-        0,
-        2324,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        197,
-        0,
-        0,
-        3672,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        465,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        111,
-        0,
-        10,
-        0,
-        0,
-        1437,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3139,
-        1403,
-        0,
-        3798,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1844,
-        0,
-        0,
-        3399,
-        0,
-        4343,
-        0,
-        0,
-        2285,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3942,
-        0,
-        0,
-        2041,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        279,
-        0,
-        0,
-        554,
-        0,
-        3653,
-        2941,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3619,
-        2238,
-        0,
-        2998,
-        0,
-        0,
-        0,
-        0,
-        92,
-        0,
-        0,
-        3055,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4053,
-        0,
-        0,
-        1384,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3214,
-        0,
-        0,
-        1825,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2751,
-        2266,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3923,
-        0,
-        0,
-        2022,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        260,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3600,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2422,
-        0,
-        0,
-        73,
-        0,
-        3740,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4034,
-        954,
-        0,
-        1365,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1806,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2732,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2789,
-        0,
-        0,
-        1976,
-        0,
-        0,
-        0,
-        0,
-        2846,
-        0,
-        0,
-        0,
-        0,
-        0,
-        516,
-        0,
-        0,
-        2903,
-        0,
-        0,
-        0,
-        0,
-        4215,
-        2173,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2403,
-        155,
-        0,
-        0,
-        0,
-        0,
-        3721,
-        705,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1530,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3270,
-        0,
-        0,
-        2713,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2559,
-        4023,
-        0,
-        2770,
-        0,
-        0,
-        1957,
-        0,
-        4594,
-        0,
-        1200,
-        2827,
-        0,
-        323,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1129,
-        2884,
-        2364,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1058,
-        0,
-        0,
-        0,
-        0,
-        0,
-        136,
-        0,
-        0,
-        987,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        916,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        50,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3179,
-        0,
-        2694,
-        3838,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4004,
-        0,
-        0,
-        1911,
-        0,
-        0,
-        586,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4279,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2108,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        218,
-        0,
-        0,
-        3693,
-        0,
-        968,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        486,
-        0,
-        897,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        31,
-        0,
-        0,
-        1458,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1304,
-        0,
-        3819,
-        4658,
-        0,
-        0,
-        0,
-        0,
-        1233,
-        0,
-        0,
-        1892,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1162,
-        386,
-        0,
-        3869,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1091,
-        3963,
-        0,
-        2326,
-        0,
-        0,
-        2089,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        199,
-        0,
-        0,
-        3674,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        467,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1657,
-        0,
-        0,
-        12,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4074,
-        0,
-        3141,
-        1405,
-        0,
-        3800,
-        656,
-        0,
-        0,
-        3235,
-        0,
-        0,
-        1846,
-        1873,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2287,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4146,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2043,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        556,
-        0,
-        0,
-        2943,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3621,
-        448,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        94,
-        0,
-        0,
-        3761,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4055,
-        0,
-        0,
-        1386,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1827,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2268,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2810,
-        3925,
-        0,
-        0,
-        2024,
-        0,
-        0,
-        0,
-        2867,
-        0,
-        0,
-        262,
-        0,
-        0,
-        537,
-        0,
-        0,
-        2924,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3602,
-        0,
-        0,
-        2981,
-        0,
-        0,
-        0,
-        0,
-        0,
-        75,
-        0,
-        3038,
-        0,
-        0,
-        1585,
-        0,
-        0,
-        4036,
-        956,
-        0,
-        3095,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1808,
-        0,
-        0,
-        0,
-        3291,
-        0,
-        0,
-        2734,
-        0,
-        2249,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2791,
-        0,
-        0,
-        1978,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2175,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2405,
-        157,
-        0,
-        1784,
-        1008,
-        0,
-        3723,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        937,
-        0,
-        1532,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2715,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1273,
-        0,
-        2772,
-        0,
-        0,
-        1959,
-        0,
-        4596,
-        0,
-        1202,
-        2829,
-        0,
-        325,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1131,
-        2886,
-        2366,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1060,
-        0,
-        0,
-        0,
-        0,
-        0,
-        138,
-        0,
-        0,
-        989,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        918,
-        0,
-        0,
-        1513,
-        0,
-        0,
-        0,
-        52,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3181,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2542,
-        4006,
-        0,
-        0,
-        1913,
-        0,
-        0,
-        588,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3890,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1112,
-        0,
-        0,
-        2347,
-        0,
-        2110,
-        0,
-        0,
-        1041,
-        0,
-        777,
-        0,
-        220,
-        0,
-        0,
-        0,
-        0,
-        970,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1712,
-        488,
-        0,
-        899,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        33,
-        0,
-        0,
-        1460,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3162,
-        0,
-        3821,
-        4660,
-        0,
-        0,
-        0,
-        0,
-        3987,
-        0,
-        0,
-        1894,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        388,
-        0,
-        3871,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3965,
-        0,
-        0,
-        0,
-        0,
-        2091,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        201,
-        0,
-        3676,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        469,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        14,
-        0,
-        0,
-        1441,
-        0,
-        0,
-        2484,
-        4076,
-        0,
-        3143,
-        3135,
-        0,
-        3802,
-        658,
-        0,
-        0,
-        3237,
-        1216,
-        0,
-        1848,
-        1875,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2289,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4148,
-        0,
-        0,
-        3946,
-        0,
-        0,
-        2045,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3657,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        450,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1640,
-        96,
-        0,
-        0,
-        3763,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4057,
-        0,
-        0,
-        1388,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3218,
-        0,
-        0,
-        1829,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2270,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2812,
-        0,
-        3927,
-        0,
-        0,
-        2026,
-        0,
-        0,
-        0,
-        2869,
-        0,
-        0,
-        264,
-        0,
-        0,
-        539,
-        0,
-        0,
-        2926,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3604,
-        0,
-        0,
-        2983,
-        0,
-        0,
-        0,
-        0,
-        77,
-        0,
-        0,
-        3744,
-        0,
-        0,
-        1587,
-        0,
-        0,
-        4038,
-        958,
-        0,
-        1369,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1810,
-        0,
-        0,
-        0,
-        3293,
-        0,
-        0,
-        0,
-        0,
-        2251,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1980,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        520,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3585,
-        1081,
-        0,
-        0,
-        0,
-        0,
-        2407,
-        159,
-        0,
-        0,
-        1010,
-        0,
-        3725,
-        0,
-        1568,
-        0,
-        0,
-        0,
-        0,
-        939,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2717,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2774,
-        0,
-        0,
-        1961,
-        609,
-        4598,
-        0,
-        0,
-        2831,
-        0,
-        327,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        140,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        920,
-        0,
-        0,
-        1515,
-        0,
-        0,
-        0,
-        54,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3183,
-        0,
-        2698,
-        0,
-        0,
-        0,
-        3349,
-        0,
-        0,
-        1256,
-        0,
-        2755,
-        1915,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1185,
-        0,
-        0,
-        3892,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1114,
-        0,
-        0,
-        2349,
-        0,
-        0,
-        0,
-        0,
-        1043,
-        0,
-        0,
-        0,
-        222,
-        0,
-        0,
-        3697,
-        0,
-        972,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        490,
-        0,
-        901,
-        0,
-        0,
-        1496,
-        0,
-        0,
-        0,
-        35,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3164,
-        0,
-        0,
-        4662,
-        0,
-        0,
-        0,
-        0,
-        3989,
-        0,
-        0,
-        1896,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        390,
-        0,
-        3873,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3967,
-        0,
-        2330,
-        0,
-        0,
-        2093,
-        0,
-        1024,
-        0,
-        0,
-        0,
-        0,
-        203,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        16,
-        0,
-        0,
-        1443,
-        0,
-        0,
-        2486,
-        4078,
-        0,
-        3145,
-        0,
-        0,
-        3804,
-        0,
-        0,
-        0,
-        3239,
-        3970,
-        0,
-        1850,
-        1877,
-        0,
-        3405,
-        0,
-        0,
-        0,
-        0,
-        2291,
-        0,
-        0,
-        0,
-        0,
-        0,
-        4150,
-        0,
-        0,
-        3948,
-        0,
-        0,
-        2047,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3659,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3625,
-        452,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1642,
-        98,
-        0,
-        0,
-        3765,
-        0,
-        1424,
-        0,
-        0,
-        0,
-        4059,
-        0,
-        0,
-        1390,
-        0,
-        0,
-        641,
-        0,
-        4529,
-        3220,
-        0,
-        0,
-        1831,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2814,
-        0,
-        0,
-        0,
-        0,
-        2028,
-        0,
-        0,
-        2623,
-        2871,
-        0,
-        0,
-        266,
-        0,
-        0,
-        541,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3606,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2428,
-        0,
-        79,
-        0,
-        0,
-        3746,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1371,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1812,
-        0,
-        0,
-        0,
-        3295,
-        0,
-        0,
-        2738,
-        0,
-        2253,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2795,
-        0,
-        0,
-        1982,
-        0,
-        0,
-        0,
-        0,
-        2852,
-        0,
-        0,
-        0,
-        0,
-        0,
-        522,
-        0,
-        0,
-        2909,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3587,
-        1083,
-        0,
-        2966,
-        0,
-        0,
-        0,
-        161,
-        0,
-        0,
-        1012,
-        0,
-        3023,
-        0,
-        1570,
-        0,
-        0,
-        0,
-        0,
-        941,
-        1352,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3276,
-        0,
-        0,
-        2719,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        1963,
-        611,
-        0,
-        0,
-        0,
-        0,
-        0,
-        329,
-        0,
-        0,
-        4401,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2160,
-        1064,
-        0,
-        0,
-        0,
-        0,
-        0,
-        142,
-        0,
-        0,
-        993,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        922,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3185,
-        0,
-        2700,
-        0,
-        0,
-        0,
-        3351,
-        0,
-        0,
-        4010,
-        0,
-        2757,
-        1917,
-        0,
-        1944,
-        592,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3894,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        2351,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        3699,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        492,
-        0,
-        0,
-        0,
-        0,
-        1498,
-        0,
-        0,
-        0,
-        37,
-};
-
-
@@ -19,11 +19,13 @@
 //#include <cmath>
 //#include "chess/board.h"
 //#include "testing/chess_gui.h"
+//#include "testing/tree_benchmark.h"
 #include <fstream>
 #include <external/SenjoUCIAdapter/senjo/UCIAdapter.h>
 #include <external/SenjoUCIAdapter/senjo/Output.h>
 #include "engine/engine_interface.h"
 #include <engine/mcts/search.h>
+#include <engine/autotune.h>
 #include <cxxopts.hpp>
 #include <filesystem>
 #include <utils/logger.h>
@@ -79,7 +81,10 @@ void stress_test(cxxopts::ParseResult& init_opts, string position)
     mcts::search s(init_opts);
     s.initialize(position);
 
-    s.expand_tree(chrono::years(1));
+    mcts::search_limits limits;
+    limits.infinite = true;
+
+    s.expand_tree(limits);
 
     cout << s.best_move()->move.to_uci_move() << endl;
 
@@ -101,7 +106,22 @@ int main(int argc, char* argv[])
             ("c,c_puct","CPuct value for non-root nodes.", cxxopts::value<float>()->default_value("1.2"))
             ("c_puct_root", "CPuct value for root nodes.", cxxopts::value<float>()->default_value("2"))
             ("s,softmax_temperature","Softmax temperature for policy.", cxxopts::value<float>()->default_value("1"))
+            ("max_edges", "Evaluated nodes keep only this many of their moves with the highest priors, "
+                          "the rest are added back if the search gets to them. 0 keeps every move.",
+                    cxxopts::value<int>()->default_value("0"))
+            ("edge_prior_mass", "Evaluated nodes keep only the moves with the highest priors that add up to this much of the policy, "
+                                "the rest are added back if the search gets to them. 1 keeps every move.",
+                    cxxopts::value<float>()->default_value("1"))
             ("t,threads", "Number of tree traversal threads.", cxxopts::value<int>()->default_value("1"))
+            ("adaptive_batch", "Adjust the batch size at which batches are sent, and the number of tree traversal threads "
+                               "that run, to what evaluates the most nodes per second. max_batch_size and threads are the limits.",
+                    cxxopts::value<bool>()->default_value("false"))
+            ("speculation", "Batches sent before they're full get up to this many unexpanded children (highest priors first) "
+                            "of each recently evaluated node, evaluated ahead of time without counting as visits. "
+                            "0 disables it.", cxxopts::value<int>()->default_value("0"))
+            ("traversals", "Playouts every tree traversal thread keeps in flight, a playout waiting for the network "
+                           "lets the thread continue with the others instead of blocking it.",
+                    cxxopts::value<int>()->default_value("1"))
             ("d,device", "[auto/cpu/cuda] or [0,1,2,...]\n"
                           "--device=cuda defaults to using all available cuda backends\n"
                           "--device=0,1,... is used to specify exactly which cuda backends should be used, for example "
@@ -109,6 +129,18 @@ int main(int argc, char* argv[])
                           "--device=cpu uses the cpu\n"
                           "--device=auto - cuda if available, otherwise cpu", cxxopts::value<string>()->default_value("auto"))
             ("cpu_inference_threads", "For use with -d cpu, defaults to half the system threads", cxxopts::value<int>()->default_value("-1"))
+            ("cpu_backends", "For use with -d cpu, number of backends that share one copy of the weights and run "
+                             "batches at the same time. --cpu_inference_threads is then per backend and "
+                             "defaults to half the system threads split between them.", cxxopts::value<int>()->default_value("1"))
+            ("numa_backends", "For use with -d cpu on NUMA machines, one backend per node with its own copy of the weights, "
+                              "threads use the ones on their node. --cpu_inference_threads is then per backend "
+                              "and defaults to half of a node's CPUs.", cxxopts::value<bool>()->default_value("false"))
+            ("numa_memory", "[none/interleave/local] Placement of the search tree on NUMA machines, "
+                            "interleave spreads it over every node, local gives every node its own arena "
+                            "that the threads running there allocate from.", cxxopts::value<string>()->default_value("none"))
+            ("pin_threads", "[none/node/core] Pins tree traversal threads (and with -d cpu their inference threads) "
+                            "to the CPUs of a NUMA node, round robin over the nodes, or to a single core each.",
+                    cxxopts::value<string>()->default_value("none"))
             ("deallocation_factor", "Deallocate nodes in bulk only when dead nodes outnumber useful nodes by "
                                 "at least deallocation-factor - low values sacrifice CPU time for memory "
                                 "efficiency, high values do the opposite.", cxxopts::value<int>()->default_value("32"))
@@ -117,14 +149,48 @@ int main(int argc, char* argv[])
             ("dirichlet_alpha", "", cxxopts::value<float>()->default_value("1"))
             ("max_batch_size", "Maximum batch size for NN, high values may cause an OOM error.",
                     cxxopts::value<int>()->default_value("1024"))
+            ("stop_latency", "Longest time in ms from a stop, or the end of the search time, to the best move. "
+                             "Batches are evaluated in chunks that take at most half of it (by the warm-up latencies), "
+                             "after a stop the rest of a batch is dropped. 0 evaluates batches whole.",
+                    cxxopts::value<int>()->default_value("100"))
+            ("move_overhead", "Time in ms kept back from every move for communication with the GUI. "
+                              "Also the MoveOverhead UCI option.", cxxopts::value<int>()->default_value("50"))
+            ("batch_buckets", "Pad batches to the next of a few fixed sizes (powers of two and halfway between), "
+                              "each warmed up at startup, so the backend doesn't meet new shapes during the search.",
+                    cxxopts::value<bool>()->default_value("true"))
+            ("memory_block_size", "Size of the search tree's memory blocks in MiB.", cxxopts::value<int>()->default_value("8"))
+            ("node_memory", "Memory budget for the search tree in MiB, 0 for no limit. Also the NodeMemory UCI option. "
+                            "At most what node handles address, 256 GiB with the default node_alignment, 64 GiB with 16 and 1 TiB with 256.",
+                    cxxopts::value<int>()->default_value("0"))
+            ("node_alignment", "Alignment of tree nodes in bytes, 64 keeps the statistics of different nodes on separate cache lines "
+                               "at the cost of 28 bytes of padding per node on average, 16 packs nodes as tightly as handles allow.",
+                    cxxopts::value<int>()->default_value("64"))
+            ("huge_pages", "Back the search tree with huge pages when available (MAP_HUGETLB, otherwise transparent huge pages).",
+                    cxxopts::value<bool>()->default_value("true"))
+            ("compaction_threads", "Threads used to compact the search tree, defaults to half the system threads.",
+                    cxxopts::value<int>()->default_value("-1"))
+            ("compaction_pause", "Longest pause in ms the search takes for a single tree compaction step.",
+                    cxxopts::value<int>()->default_value("5"))
+            ("prune_hashfull", "With --node_memory, prune cold subtrees once this per mille of the budget is used, 0 disables pruning.",
+                    cxxopts::value<int>()->default_value("800"))
+            ("autotune", "Search a few positions with a grid of --threads, --max_batch_size and (with -d cpu) --cpu_backends "
+                         "settings, then save the fastest to --profiles and exit.", cxxopts::value<bool>()->default_value("false"))
+            ("autotune_time", "Time in ms every setting searches each of the autotune positions.",
+                    cxxopts::value<int>()->default_value("2000"))
+            ("profiles", "File with the autotuned settings per CPU model, network and device, they're used unless "
+                         "the command line sets them. none disables them.", cxxopts::value<string>()->default_value("firefly_profiles.txt"))
             ("graph_log_file", "Log for graphviz logging of the search tree.", cxxopts::value<std::string>()->default_value("none"))
             ("general_log_file", "File for general logging.", cxxopts::value<std::string>()->default_value("none"));
 
     options.set_width(120);
 
+    // Some versions of cxxopts consume argv while parsing, the profile's options are added to a copy
+    vector<string> args(argv, argv + argc);
+
     cxxopts::ParseResult result = options.parse(argc, argv);
 
     //stress_test(result, "r4k1r/4bp2/pqppbp2/5p2/4P2p/1BN4P/PPP1Q1P1/1K1R1R2 b - - 3 18");
+    //tree_scaling_benchmark({1, 2, 4, 8, 16, 32});
 
     if (result["h"].count() > 0)
     {
@@ -176,7 +242,25 @@ int main(int argc, char* argv[])
     }
 
 
-    start_engine(result);
+    auto profiles = result["profiles"].as<string>();
+    auto profile_key = autotune::profile_key(neural_net_path, result["d"].as<string>());
+
+    if (result["autotune"].as<bool>())
+    {
+        auto best = autotune::run(options, args, chrono::milliseconds(result["autotune_time"].as<int>()));
+
+        if (profiles != "none")
+            autotune::save_profile(profiles, profile_key, best);
+
+        logging::flush_all();
+        return 0;
+    }
+
+    if (profiles != "none")
+        args = autotune::apply_profile(result, args, autotune::load_profile(profiles, profile_key));
+
+    cxxopts::ParseResult tuned_result = autotune::parse(options, args);
+    start_engine(tuned_result);
 
     if (graph_log != "none")
     {
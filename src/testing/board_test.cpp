@@ -19,9 +19,11 @@
 #include "board_test.h"
 #include <utils/utils.h>
 #include "chess_gui.h"
+#include <chess/batch_movegen.h>
 #include <chrono>
 #include <sstream>
 #include <unordered_map>
+#include <algorithm>
 
 void board_stress_test()
 {
@@ -126,6 +128,136 @@ void fen_perft(string fen, int depth, string expected_str)
     cout << '\n' << "Total nodes: " << total_nodes << " computed in " << exec_time << "ms." << endl;
 }
 
+
+/*
+ * Walks the perft tree of fen, generating every level with chess::generate_moves_batch
+ * and checking each board's moves against the scalar board::generate_moves.
+ */
+uint64_t batch_movegen_perft_internal(std::vector<chess::board> const& boards, int depth, uint64_t& mismatches)
+{
+    if (depth == 0) return boards.size();
+
+    const size_t chunk_size = 256;
+
+    std::vector<const chess::board*> board_ptrs(chunk_size);
+    std::vector<chess::movegen_result> batch_results(chunk_size);
+    std::vector<chess::game_state> batch_states(chunk_size);
+    std::vector<chess::board> next_level;
+    chess::movegen_result scalar_result;
+
+    uint64_t nodes = 0;
+
+    for (size_t first = 0; first < boards.size(); first += chunk_size)
+    {
+        auto n = std::min(chunk_size, boards.size() - first);
+
+        for (size_t i = 0; i < n; i++)
+            board_ptrs[i] = &boards[first + i];
+
+        chess::generate_moves_batch(board_ptrs.data(), batch_results.data(), batch_states.data(), n);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            auto& board = boards[first + i];
+            auto& batched = batch_results[i];
+            auto scalar_state = board.generate_moves(scalar_result);
+
+            std::vector<string> batched_moves, scalar_moves;
+            for (int m = 0; m < batched.moves_count; m++) batched_moves.push_back(batched.moves[m].to_uci_move());
+            for (int m = 0; m < scalar_result.moves_count; m++) scalar_moves.push_back(scalar_result.moves[m].to_uci_move());
+
+            std::sort(batched_moves.begin(), batched_moves.end());
+            std::sort(scalar_moves.begin(), scalar_moves.end());
+
+            if (batched_moves != scalar_moves || batch_states[i] != scalar_state)
+            {
+                if (mismatches++ < 10)
+                    cout << "Mismatch: " << board.to_fen() << "  batched: " << batched.moves_count <<
+                    "  scalar: " << scalar_result.moves_count << endl;
+            }
+
+            if (depth == 1)
+            {
+                nodes += batched.moves_count;
+                continue;
+            }
+
+            for (int m = 0; m < batched.moves_count; m++)
+            {
+                next_level.push_back(board);
+                next_level.back().make_move(batched.moves[m]);
+            }
+        }
+
+        if (depth > 1)
+        {
+            nodes += batch_movegen_perft_internal(next_level, depth - 1, mismatches);
+            next_level.clear();
+        }
+    }
+
+    return nodes;
+}
+
+void batch_movegen_perft(string fen, int depth)
+{
+    chess::board board;
+    board.from_fen(fen);
+
+    cout << "Batch movegen perft for FEN: " << fen << "\nDepth: " << depth << endl;
+
+    uint64_t mismatches = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto nodes = batch_movegen_perft_internal({board}, depth, mismatches);
+    auto exec_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - start).count();
+
+    cout << "Total nodes: " << nodes << " computed in " << exec_time << "ms, " <<
+    mismatches << " positions differ from board::generate_moves." << endl;
+}
+
+bool perft_regression_test()
+{
+    struct perft_case
+    {
+        const char* fen;
+        int depth;
+        uint64_t expected;
+    };
+
+    const perft_case cases[] = {
+        // Kiwipete, a queen on the en passant rank x-raying the king along a file used to forbid en passant
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603},
+        {"r4k1r/p1ppqpb1/bn2pnp1/3PN3/Pp2PQ2/2N4p/1PPBBPPP/R3K2R b KQ a4 0 1", 1, 42},
+        {"r4rk1/p1ppqpb1/bn2pnp1/3PN3/Pp2P1Q1/2N4p/1PPBBPPP/R3K2R b KQ a4 0 1", 1, 41},
+        // En passant really exposes the king along the rank
+        {"8/8/8/KPp4r/8/8/8/7k w - c6 0 1", 1, 4},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624}
+    };
+
+    bool passed = true;
+
+    for (auto& c : cases)
+    {
+        chess::board board;
+        board.from_fen(c.fen);
+
+        uint64_t scalar = 0, mismatches = 0;
+        for (auto& i : board.perft(c.depth)) scalar += i.second;
+
+        auto batched = batch_movegen_perft_internal({board}, c.depth, mismatches);
+
+        bool ok = scalar == c.expected && batched == c.expected && mismatches == 0;
+        passed &= ok;
+
+        cout << (ok ? "OK " : "FAIL ") << c.fen << " depth " << c.depth << ": scalar " << scalar << ", batched " <<
+        batched << ", expected " << c.expected << endl;
+    }
+
+    return passed;
+}
+
 int mai00n()
 {
     //print_bitboard(9259542123273814144);
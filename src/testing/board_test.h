@@ -25,5 +25,9 @@ void board_stress_test();
 void test_pos(string fen);
 void test_pos(chess::board b);
 void fen_perft(string fen, int depth, string expected_values="");
+void batch_movegen_perft(string fen, int depth);
+
+// Perft of positions that once went wrong, with both move generators. Returns false on any mismatch.
+bool perft_regression_test();
 
 #endif //FIREFLY_BOARD_TEST_H
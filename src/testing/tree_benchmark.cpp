@@ -0,0 +1,193 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "tree_benchmark.h"
+
+#include <engine/mcts/node.h>
+#include <engine/mcts/memory.h>
+#include <engine/mcts/path_history.h>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+namespace
+{
+    constexpr float c_puct_root = 2, c_puct = 1.2;
+    constexpr size_t benchmark_memory = size_t(4) << 30;
+
+    // Stand-in for the network, same order of work on the node as blocking_inference
+    void fake_evaluation(mcts::node* node)
+    {
+        auto Q_ = float(node->position_hash % 2001) / 1000 - 1;
+
+        node->Q_ = Q_;
+        node->visits_pending = 0;
+        node->visit_count = 1;
+
+        if (node->parent)
+            node->parent->update_value(-Q_);
+
+        for (auto& i : *node)
+            i.set_prior(1.f / node->edge_count);
+
+        node->evaluated = true;
+        node->unlock();
+    }
+
+    // One traversal thread, the same selection as search::expand_tree_puct_worker_synchronous
+    void playouts(mcts::node* root, memory& memory_, mcts::path_history const& root_history,
+                  uint8_t tid, atomic<bool> const& stop, size_t& count)
+    {
+        mcts::node::thread_id = tid;
+
+        mcts::path_history path;
+        path.assign(root_history);
+
+        vector<mcts::batch_entry> batch;
+
+        while (!stop)
+        {
+            path.truncate(root_history.size());
+
+            auto edge_parent = root;
+            edge_parent->lock();
+            auto selected_edge = root->puct_select(c_puct_root);
+
+            while (selected_edge && selected_edge->is_expanded() && !selected_edge->is_terminal())
+            {
+                auto next_node = selected_edge->get_node();
+                edge_parent->unlock();
+
+                // Evaluation is immediate, another thread is just about to finish it (and move the node)
+                while (next_node && !next_node->evaluated)
+                {
+                    this_thread::yield();
+                    next_node = selected_edge->get_node();
+                }
+
+                if (!next_node)
+                {
+                    edge_parent->cancel_pending_visits();
+                    selected_edge = nullptr;
+                    edge_parent = nullptr;
+                    break;
+                }
+
+                edge_parent = next_node;
+                path.push(selected_edge->move, edge_parent->repetitions);
+
+                edge_parent->lock();
+                selected_edge = edge_parent->puct_select(c_puct);
+            }
+
+            // Ran into a leaf that turned out to be terminal
+            if (!edge_parent)
+                continue;
+
+            if (selected_edge && !selected_edge->is_expanded() && selected_edge->expand(edge_parent, memory_, path))
+            {
+                // Leaves get their edges the same way as in a batch
+                path.push(selected_edge->move, selected_edge->get_node()->repetitions);
+                batch.assign(1, mcts::batch_entry(selected_edge->get_node(), path));
+                path.pop();
+
+                mcts::node* node;
+                mcts::materialize_leaves(batch, memory_, &node);
+
+                if (node)
+                    fake_evaluation(node);
+
+                batch[0].node->evaluated = true;
+            }
+
+            edge_parent->unlock();
+
+            if (memory_.is_exhausted() || root->is_solved())
+                break;
+
+            count++;
+        }
+    }
+
+    double run(size_t n_threads, size_t alignment, chrono::milliseconds duration, string const& fen)
+    {
+        memory memory_(16, size_t(8) << 20, true, alignment);
+        memory_.set_budget(benchmark_memory);
+
+        chess::board board;
+        board.from_fen(fen);
+
+        chess::movegen_result moves;
+        board.generate_moves(moves);
+
+        mcts::node::thread_id = 0;
+        auto root = new (memory_.allocate_fused_node(moves.moves_count)) mcts::node(board, moves, nullptr);
+        ::current_root = root;
+        fake_evaluation(root);
+
+        mcts::path_history root_history;
+        root_history.push(board, 0);
+
+        atomic<bool> stop = false;
+        vector<size_t> counts(n_threads * 16, 0); // Counters a cache line apart
+        vector<thread> threads;
+
+        auto start = chrono::high_resolution_clock::now();
+
+        for (size_t i = 0; i < n_threads; i++)
+            threads.emplace_back(playouts, root, ref(memory_), cref(root_history), uint8_t(i + 1), cref(stop), ref(counts[i * 16]));
+
+        this_thread::sleep_for(duration);
+        stop = true;
+
+        for (auto& i : threads)
+            i.join();
+
+        auto seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+
+        size_t total = 0;
+        for (size_t i = 0; i < n_threads; i++)
+            total += counts[i * 16];
+
+        return total / seconds;
+    }
+}
+
+
+void tree_scaling_benchmark(vector<size_t> const& thread_counts, chrono::milliseconds duration, string const& fen)
+{
+    for (size_t alignment : {size_t(8), size_t(64)})
+    {
+        cout << "Node alignment " << alignment << " bytes" << endl;
+
+        double single_thread = 0;
+
+        for (auto n_threads : thread_counts)
+        {
+            auto playouts_per_second = run(n_threads, alignment, duration, fen);
+
+            if (n_threads == 1 || single_thread == 0)
+                single_thread = playouts_per_second / n_threads;
+
+            cout << setw(4) << n_threads << " threads: " << setw(10) << size_t(playouts_per_second) << " playouts/s, "
+                 << fixed << setprecision(2) << playouts_per_second / single_thread << "x" << endl;
+        }
+    }
+}
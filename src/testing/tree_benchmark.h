@@ -0,0 +1,40 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_TREE_BENCHMARK_H
+#define FIREFLY_TREE_BENCHMARK_H
+
+#include <vector>
+#include <chrono>
+#include <string>
+
+/*
+ * Measures how tree traversal scales with the number of threads, without a network.
+ *
+ * Every thread runs playouts the same way the synchronous search worker does, selection under node locks,
+ * expansion, then an immediate fake evaluation (value from the position hash, uniform priors) and backpropagation.
+ * This is the part of the search where threads contend for the same nodes.
+ *
+ * Runs every thread count once with packed nodes (8 byte alignment) and once with cache line aligned nodes,
+ * then prints playouts per second and the speedup over a single thread.
+ */
+void tree_scaling_benchmark(std::vector<size_t> const& thread_counts = {1, 2, 4, 8, 16, 32},
+                            std::chrono::milliseconds duration = std::chrono::seconds(3),
+                            std::string const& fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+#endif //FIREFLY_TREE_BENCHMARK_H
@@ -0,0 +1,205 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "tree_test.h"
+
+#include <engine/mcts/node.h>
+#include <engine/mcts/memory.h>
+#include <engine/mcts/path_history.h>
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+    // Stand-in for the network, the values differ by position so the best move isn't the first edge
+    void fake_evaluation(mcts::node* node)
+    {
+        auto Q_ = float(node->position_hash % 2001) / 1000 - 1;
+
+        node->Q_ = Q_;
+        node->visits_pending = 0;
+        node->visit_count = 1;
+
+        if (node->parent)
+            node->parent->update_value(-Q_);
+
+        for (auto& i : *node)
+            i.set_prior(1.f / node->edge_count);
+
+        node->evaluated = true;
+        node->unlock();
+    }
+
+    // Expands and evaluates every child of node, the bare leaves left behind are retired into retired if given
+    void expand_children(mcts::node* node, memory& memory_, mcts::path_history& path,
+                         vector<mcts::node*>* retired = nullptr)
+    {
+        vector<mcts::batch_entry> batch;
+
+        node->lock();
+
+        for (auto& i : *node)
+        {
+            if (i.is_expanded() || !i.expand(node, memory_, path))
+                continue;
+
+            path.push(i.move, i.get_node()->repetitions);
+            batch.assign(1, mcts::batch_entry(i.get_node(), path));
+            path.pop();
+
+            mcts::node* leaf;
+            mcts::materialize_leaves(batch, memory_, &leaf);
+
+            if (leaf)
+                fake_evaluation(leaf);
+
+            batch[0].node->evaluated = true;
+
+            if (retired)
+            {
+                memory_.retire_leaf(batch[0].node);
+                retired->push_back(batch[0].node);
+            }
+        }
+
+        node->unlock();
+    }
+}
+
+
+bool compaction_best_move_test(string const& fen)
+{
+    memory memory_(16, size_t(1) << 20, false, 16);
+
+    chess::board board;
+    board.from_fen(fen);
+
+    chess::movegen_result moves;
+    board.generate_moves(moves);
+
+    mcts::node::thread_id = 0;
+    auto root = new (memory_.allocate_fused_node(moves.moves_count)) mcts::node(board, moves, nullptr);
+    ::current_root = root;
+    fake_evaluation(root);
+
+    mcts::path_history path;
+    path.push(board, 0);
+
+    expand_children(root, memory_, path);
+
+    // A level below the root, so the compaction takes a few steps
+    for (auto& i : *root)
+    {
+        if (!i.get_node() || !i.get_node()->has_edges())
+            continue;
+
+        path.push(i.move, i.get_node()->repetitions);
+        expand_children(i.get_node(), memory_, path);
+        path.pop();
+    }
+
+    std::vector<std::unique_ptr<mcts::node>> erased_parents;
+    root = memory_.begin_compaction(root, erased_parents);
+    ::current_root = root;
+
+    auto best = root->best_edge_by_value();
+    auto best_move = best->move;
+
+    // One node per step at most, the root's children are moved after the selection
+    while (!memory_.compaction_step(chrono::high_resolution_clock::now(), 1));
+
+    bool passed = best->move == best_move;
+    size_t children = 0;
+
+    for (auto& i : *root)
+    {
+        auto child = i.get_node();
+        if (!child)
+            continue;
+
+        children++;
+
+        // The edge's move has to lead to the node's position, not just to some child of the root
+        auto child_board = board;
+        child_board.make_move(i.move);
+
+        if (child->parent != root || child->get_own_edge() != &i || child->position_hash != child_board.hash())
+        {
+            passed = false;
+            cout << "Mismatch: " << i.move.to_uci_move() << " is edge " << &i - root->begin() <<
+            ", its node points to edge " << int(child->index_in_parent) << endl;
+        }
+    }
+
+    cout << (passed ? "OK " : "FAIL ") << "best move " << best_move.to_uci_move() << " (edge " << best - root->begin() <<
+    "), " << children << " children of the root checked after the compaction" << endl;
+
+    return passed;
+}
+
+
+bool leaf_recycling_test(string const& fen)
+{
+    memory memory_(16, size_t(1) << 20, false, 16);
+    memory_.set_traversal_threads(1);
+
+    chess::board board;
+    board.from_fen(fen);
+
+    chess::movegen_result moves;
+    board.generate_moves(moves);
+
+    mcts::node::thread_id = 0;
+    auto root = new (memory_.allocate_fused_node(moves.moves_count)) mcts::node(board, moves, nullptr);
+    ::current_root = root;
+    fake_evaluation(root);
+
+    mcts::path_history path;
+    path.push(board, 0);
+
+    // The traversal thread may still be waiting on any of the leaves
+    memory_.begin_traversals(0);
+
+    vector<mcts::node*> retired;
+    expand_children(root, memory_, path, &retired);
+
+    auto is_retired = [&retired](mcts::node* node) {
+        return std::find(retired.begin(), retired.end(), node) != retired.end();
+    };
+
+    auto early = memory_.allocate_leaf();
+    bool passed = !retired.empty() && !is_retired(early);
+
+    // Woken up, the headers are free from now on
+    memory_.traversals_quiescent(0);
+
+    size_t reused = 0;
+    for (size_t i = 0; i < retired.size(); i++)
+        reused += is_retired(memory_.allocate_leaf());
+
+    passed = passed && reused == retired.size();
+
+    cout << (passed ? "OK " : "FAIL ") << reused << " of " << retired.size() << " leaf headers reused, " <<
+    (is_retired(early) ? "one" : "none") << " before the traversal thread was quiescent" << endl;
+
+    memory_.end_traversals(0);
+
+    return passed;
+}
@@ -0,0 +1,38 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_TREE_TEST_H
+#define FIREFLY_TREE_TEST_H
+
+#include <string>
+
+/*
+ * Picks the best move of a root whose children are still waiting to be moved by a compaction (as go does
+ * before resume_compaction), finishes the compaction and checks that every child of the root is found
+ * through its own edge and is the position of that edge's move. Returns false if one isn't.
+ */
+bool compaction_best_move_test(std::string const& fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+/*
+ * Evaluates the children of a root with one traversal thread registered and checks that their bare leaf headers
+ * are only handed out for new leaves once that thread has been quiescent. Returns false if one is reused earlier
+ * or never.
+ */
+bool leaf_recycling_test(std::string const& fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+#endif //FIREFLY_TREE_TEST_H
@@ -28,11 +28,16 @@
 #include <cstdint>
 #include <atomic>
 #include <thread>
+#include "parking.h"
+
+inline parking::site fsts_queue_lock_site("queue try locks"), fsts_queue_order_site("queue ordering"),
+                     fsts_queue_space_site("full queue"), fsts_queue_items_site("empty queue");
 
 /*
  * fixed size lockless thread-safe queue.
+ * Waiting (for space, items or the threads with earlier indices) spins briefly and then parks, see parking.h.
  */
-template<typename T, size_t SleepIntervalNS=0>
+template<typename T>
 struct fsts_queue
 {
     const uint64_t Size;
@@ -78,45 +83,39 @@ struct fsts_queue
 
     bool try_push(const T& in) noexcept
     {
-        bool f = false;
-        while (!try_write_lock.compare_exchange_weak(f, true))
-            f = false;
+        acquire(try_write_lock);
 
         if (write_pointer >= (front + Size))
         {
-            try_write_lock = false;
+            release(try_write_lock);
             return false;
         }
 
         auto index = write_pointer++;
-        try_write_lock = false;
+        release(try_write_lock);
 
         data[index & M] = in;
 
-        while (back != index);
-        back++;
+        publish(index);
         return true;
     }
 
     bool try_pop(T& out) noexcept
     {
-        bool f = false;
-        while (!try_read_lock.compare_exchange_weak(f, true))
-            f = false;
+        acquire(try_read_lock);
 
         if (read_pointer >= back)
         {
-            try_read_lock = false;
+            release(try_read_lock);
             return false;
         }
 
         auto index = read_pointer++;
-        try_read_lock = false;
+        release(try_read_lock);
 
         out = data[index & M];
 
-        while (front != index);
-        front++;
+        consume(index);
 
         return true;
     }
@@ -126,19 +125,14 @@ struct fsts_queue
     {
         auto index = write_pointer++;
 
-        while (index >= (front + Size)) if constexpr(SleepIntervalNS != 0)
-                std::this_thread::sleep_for(std::chrono::nanoseconds(SleepIntervalNS));
+        parking::wait_until(front, [&]() {
+            return index < front + Size;
+        }, fsts_queue_space_site);
 
 
         data[index & M] = in;         // Set data
 
-        // Block until all threads with reserved indices lower than index have done their work
-        // This is necessary because otherwise a thread with index == 3 might finish its work before another
-        // thread with index == 1, if that first thread increments back before the second thread, that might prompt
-        // a reader to read data from index == 1, that has not been successfully written yet.
-
-        while (back != index);
-        back++;                       // Increment back to signal that data is available for reading
+        publish(index);
     }
 
 
@@ -149,17 +143,63 @@ struct fsts_queue
     {
         auto index = read_pointer++;
 
-        while (index >= back) if constexpr(SleepIntervalNS != 0)
-                std::this_thread::sleep_for(std::chrono::nanoseconds(SleepIntervalNS));
+        parking::wait_until(back, [&]() {
+            return index < back;
+        }, fsts_queue_items_site);
 
 
         auto out = data[index & M];
 
-        while (front != index);
-        front++;
+        consume(index);
 
         return out;
     }
+
+private:
+    inline void acquire(std::atomic<bool>& lock) noexcept
+    {
+        parking::wait_until(lock, [&]() {
+            bool f = false;
+            return lock.compare_exchange_strong(f, true);
+        }, fsts_queue_lock_site);
+    }
+
+    inline void release(std::atomic<bool>& lock) noexcept
+    {
+        lock = false;
+        parking::notify(lock, fsts_queue_lock_site);
+    }
+
+    // Makes the element at index readable
+    inline void publish(uint64_t index) noexcept
+    {
+        // Block until all threads with reserved indices lower than index have done their work
+        // This is necessary because otherwise a thread with index == 3 might finish its work before another
+        // thread with index == 1, if that first thread increments back before the second thread, that might prompt
+        // a reader to read data from index == 1, that has not been successfully written yet.
+
+        parking::wait_until(back, [&]() {
+            return back == index;
+        }, fsts_queue_order_site);
+
+        back++;                       // Increment back to signal that data is available for reading
+
+        parking::notify(back, fsts_queue_order_site);
+        parking::notify(back, fsts_queue_items_site);
+    }
+
+    // Frees the slot at index for writing
+    inline void consume(uint64_t index) noexcept
+    {
+        parking::wait_until(front, [&]() {
+            return front == index;
+        }, fsts_queue_order_site);
+
+        front++;
+
+        parking::notify(front, fsts_queue_order_site);
+        parking::notify(front, fsts_queue_space_site);
+    }
 };
 
 #endif //FIREFLY_FSTS_QUEUE_H
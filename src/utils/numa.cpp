@@ -0,0 +1,331 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "numa.h"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    thread_local int pinned_node = -1;
+
+    // Parses lists such as "0-3,8,10-11"
+    vector<int> parse_cpu_list(string const& list)
+    {
+        vector<int> cpus;
+        stringstream ss(list);
+        string range;
+
+        while (getline(ss, range, ','))
+        {
+            if (range.empty() || range == "\n")
+                continue;
+
+            auto dash = range.find('-');
+            int first = stoi(range.substr(0, dash));
+            int last = dash == string::npos ? first : stoi(range.substr(dash + 1));
+
+            for (int i = first; i <= last; i++)
+                cpus.push_back(i);
+        }
+
+        return cpus;
+    }
+
+    // Prints a list of CPUs the way sysfs does
+    string format_cpu_list(vector<int> const& cpus)
+    {
+        stringstream ss;
+
+        for (size_t i = 0; i < cpus.size();)
+        {
+            size_t j = i;
+            while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1)
+                j++;
+
+            if (i) ss << ",";
+            ss << cpus[i];
+            if (j > i) ss << "-" << cpus[j];
+
+            i = j + 1;
+        }
+
+        return ss.str();
+    }
+
+    numa::topology detect()
+    {
+        numa::topology result;
+        vector<int> allowed;
+
+#ifdef __linux__
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+
+        if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+            for (int i = 0; i < CPU_SETSIZE; i++)
+                if (CPU_ISSET(i, &mask))
+                    allowed.push_back(i);
+
+        string online;
+        ifstream online_file("/sys/devices/system/node/online");
+
+        if (online_file && getline(online_file, online))
+        {
+            for (auto node : parse_cpu_list(online))
+            {
+                ifstream cpulist_file("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+                string cpulist;
+
+                if (!cpulist_file || !getline(cpulist_file, cpulist))
+                    continue;
+
+                vector<int> cpus;
+                for (auto cpu : parse_cpu_list(cpulist))
+                    if (allowed.empty() || binary_search(allowed.begin(), allowed.end(), cpu))
+                        cpus.push_back(cpu);
+
+                // Memory only nodes and nodes the process can't run on
+                if (cpus.empty())
+                    continue;
+
+                // Nodes are numbered by their position, the kernel's number is only needed for the memory policies
+                if (result.cpu_node.size() <= size_t(cpus.back()))
+                    result.cpu_node.resize(cpus.back() + 1, -1);
+
+                for (auto cpu : cpus)
+                    result.cpu_node[cpu] = node;
+
+                result.node_cpus.push_back(std::move(cpus));
+            }
+        }
+#endif
+
+        if (result.node_cpus.empty())
+        {
+            if (allowed.empty())
+                for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); i++)
+                    allowed.push_back(int(i));
+
+            result.node_cpus.assign(1, allowed);
+            result.cpu_node.assign(allowed.back() + 1, 0);
+        }
+
+        return result;
+    }
+
+    // Kernel node number of a node index, they differ when nodes without usable CPUs are skipped
+    int kernel_node(int node)
+    {
+        auto& topology = numa::get_topology();
+        return topology.cpu_node[topology.node_cpus[node][0]];
+    }
+
+    int node_index(int kernel_node)
+    {
+        auto& topology = numa::get_topology();
+
+        for (size_t i = 0; i < topology.nodes(); i++)
+            if (topology.cpu_node[topology.node_cpus[i][0]] == kernel_node)
+                return int(i);
+
+        return 0;
+    }
+
+    bool pin_to_cpus(vector<int> const& cpus)
+    {
+#ifdef __linux__
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+
+        for (auto cpu : cpus)
+            CPU_SET(cpu, &mask);
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+#else
+        return false;
+#endif
+    }
+
+#ifdef __linux__
+    bool set_policy(void* address, size_t size, int mode, unsigned long const* nodemask, size_t max_node, bool move)
+    {
+        return syscall(SYS_mbind, address, size, mode, nodemask, max_node + 1, move ? MPOL_MF_MOVE : 0) == 0;
+    }
+#endif
+}
+
+
+numa::topology const& numa::get_topology()
+{
+    static const topology detected = detect();
+    return detected;
+}
+
+
+numa::placement numa::parse_placement(string const& name)
+{
+    if (name == "none") return placement::none;
+    if (name == "interleave") return placement::interleave;
+    if (name == "local") return placement::local;
+
+    throw std::invalid_argument("Unknown NUMA memory placement " + name + ", expected none, interleave or local.");
+}
+
+
+numa::pinning numa::parse_pinning(string const& name)
+{
+    if (name == "none") return pinning::none;
+    if (name == "node") return pinning::node;
+    if (name == "core") return pinning::core;
+
+    throw std::invalid_argument("Unknown thread pinning " + name + ", expected none, node or core.");
+}
+
+
+void numa::report(placement memory_placement, pinning thread_pinning, bool per_node_backends)
+{
+    auto& topology = get_topology();
+
+    for (size_t i = 0; i < topology.nodes(); i++)
+        cout << "info [numa] Node " << i << " (kernel node " << kernel_node(int(i)) << "): "
+             << topology.node_cpus[i].size() << " CPU(s) " << format_cpu_list(topology.node_cpus[i]) << endl;
+
+    const char* placement_names[] = {"none", "interleave", "local"};
+    const char* pinning_names[] = {"none", "node", "core"};
+
+    cout << "info [numa] Memory placement " << placement_names[int(memory_placement)]
+         << ", thread pinning " << pinning_names[int(thread_pinning)]
+         << ", " << (per_node_backends ? "one CPU backend per node" : "shared CPU backends") << endl;
+
+    if (topology.nodes() == 1 && (memory_placement != placement::none || thread_pinning == pinning::node || per_node_backends))
+        cout << "info [numa] Single node, NUMA settings have no effect." << endl;
+}
+
+
+int numa::pin_worker(size_t index, pinning mode)
+{
+    auto& topology = get_topology();
+
+    if (mode == pinning::none)
+        return -1;
+
+    int node = int(index % topology.nodes());
+    auto& cpus = topology.node_cpus[node];
+
+    bool pinned = mode == pinning::node ?
+                  pin_to_cpus(cpus) :
+                  pin_to_cpus({cpus[(index / topology.nodes()) % cpus.size()]});
+
+    if (!pinned)
+        return -1;
+
+    pinned_node = node;
+    return node;
+}
+
+
+bool numa::pin_to_node(int node)
+{
+    if (!pin_to_cpus(get_topology().node_cpus[node]))
+        return false;
+
+    pinned_node = node;
+    return true;
+}
+
+
+int numa::current_node()
+{
+    if (pinned_node >= 0)
+        return pinned_node;
+
+#ifdef __linux__
+    auto& topology = get_topology();
+
+    if (topology.nodes() == 1)
+        return 0;
+
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && size_t(cpu) < topology.cpu_node.size() && topology.cpu_node[cpu] >= 0)
+        return node_index(topology.cpu_node[cpu]);
+#endif
+
+    return 0;
+}
+
+
+bool numa::bind_memory(void* address, size_t size, int node, bool move)
+{
+#ifdef __linux__
+    if (get_topology().nodes() == 1)
+        return false;
+
+    // Preferred rather than bound, a full node falls back to the others instead of failing the allocation
+    unsigned long nodemask[16] = {};
+    auto kernel = size_t(kernel_node(node));
+
+    if (kernel >= sizeof(nodemask) * 8)
+        return false;
+
+    nodemask[kernel / 64] |= 1ul << (kernel % 64);
+
+    return set_policy(address, size, MPOL_PREFERRED, nodemask, sizeof(nodemask) * 8, move);
+#else
+    return false;
+#endif
+}
+
+
+bool numa::interleave_memory(void* address, size_t size, bool move)
+{
+#ifdef __linux__
+    auto& topology = get_topology();
+
+    if (topology.nodes() == 1)
+        return false;
+
+    unsigned long nodemask[16] = {};
+
+    for (size_t i = 0; i < topology.nodes(); i++)
+    {
+        auto kernel = size_t(kernel_node(int(i)));
+        if (kernel < sizeof(nodemask) * 8)
+            nodemask[kernel / 64] |= 1ul << (kernel % 64);
+    }
+
+    return set_policy(address, size, MPOL_INTERLEAVE, nodemask, sizeof(nodemask) * 8, move);
+#else
+    return false;
+#endif
+}
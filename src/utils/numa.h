@@ -0,0 +1,92 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_NUMA_H
+#define FIREFLY_NUMA_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+/*
+ * NUMA topology and placement, straight on top of sysfs and the Linux syscalls, no libnuma needed.
+ *
+ * On other systems, or when sysfs isn't there, the machine is a single node holding every CPU
+ * and all the placement functions do nothing.
+ */
+namespace numa
+{
+    // Where the blocks of the search tree live, see memory
+    enum class placement
+    {
+        none,       // Wherever the kernel puts the first touch
+        interleave, // Pages spread round robin over every node
+        local       // One arena per node, threads allocate from the arena of the node they run on
+    };
+
+    // Which CPUs the search threads are allowed to run on
+    enum class pinning
+    {
+        none,
+        node,   // Thread i on every CPU of node i % nodes
+        core    // Thread i on a single CPU, consecutive threads alternate between nodes
+    };
+
+    struct topology
+    {
+        std::vector<std::vector<int>> node_cpus; // CPUs this process may use, by node
+        std::vector<int> cpu_node;               // Node of every CPU, -1 for CPUs that aren't usable
+
+        inline size_t nodes() const
+        {
+            return node_cpus.size();
+        }
+    };
+
+    // Detected on first use, only CPUs in the process' affinity mask are counted
+    topology const& get_topology();
+
+    // Throw std::invalid_argument for unknown names
+    placement parse_placement(std::string const& name);
+    pinning parse_pinning(std::string const& name);
+
+    // Prints the nodes, their CPUs and the chosen settings as info strings
+    void report(placement memory_placement, pinning thread_pinning, bool per_node_backends);
+
+    /*
+     * Restricts the calling thread to the CPUs for worker thread index.
+     * Threads created afterwards by the calling thread (OpenMP teams of the CPU backends) inherit the mask.
+     * Returns the node the thread was pinned to, -1 if it wasn't.
+     */
+    int pin_worker(size_t index, pinning mode);
+
+    // Restricts the calling thread to every CPU of a node
+    bool pin_to_node(int node);
+
+    // Node the calling thread was pinned to, otherwise the node of the CPU it's currently running on
+    int current_node();
+
+    /*
+     * Memory policies for a page aligned range. With move, pages that are already touched get migrated,
+     * otherwise only pages touched from now on follow the policy.
+     */
+    bool bind_memory(void* address, size_t size, int node, bool move);
+    bool interleave_memory(void* address, size_t size, bool move);
+}
+
+#endif //FIREFLY_NUMA_H
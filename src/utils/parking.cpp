@@ -0,0 +1,61 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "parking.h"
+
+namespace
+{
+    // Sites are only ever added, during static initialization
+    std::atomic<parking::site*> sites = nullptr;
+}
+
+
+parking::site::site(const char* name) : name(name), next(sites.load())
+{
+    while (!sites.compare_exchange_weak(next, this));
+}
+
+
+void parking::report(std::ostream& out)
+{
+    for (auto s = sites.load(); s; s = s->next)
+    {
+        auto waits = s->waits.load(std::memory_order_relaxed);
+
+        if (waits == 0)
+            continue;
+
+        auto parks = s->parks.load(std::memory_order_relaxed);
+
+        out << "info [sync] " << s->name << ": " << waits << " waits, " << parks << " parked, "
+            << s->spins.load(std::memory_order_relaxed) << " spins";
+
+        out << ", spin limit " << s->spin_limit.load(std::memory_order_relaxed) << std::endl;
+    }
+}
+
+
+void parking::reset()
+{
+    for (auto s = sites.load(); s; s = s->next)
+    {
+        s->waits = 0;
+        s->parks = 0;
+        s->spins = 0;
+    }
+}
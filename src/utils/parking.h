@@ -0,0 +1,141 @@
+/*
+    Firefly Chess Engine
+    Copyright (C) 2022  Ognyan Mirev
+
+    This program is free software: you can redistribute it and/or modify
+            it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+            but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIREFLY_PARKING_H
+#define FIREFLY_PARKING_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+#include <algorithm>
+
+/*
+ * Spin-then-park waiting.
+ *
+ * A waiter spins (with the CPU's pause hint) for a while, yields a few times, and if the condition still doesn't hold it parks
+ * in std::atomic::wait on a watched atomic, a futex on Linux, so it stops taking CPU time from the threads
+ * that do the work, the CPU backends' inference threads in particular.
+ *
+ * Whoever makes the condition true has to change the watched atomic and call notify afterwards,
+ * notify only wakes anyone (a syscall) if a thread is actually parked at that site.
+ *
+ * Every waiting site has its own counters and its own spin budget, which grows while spinning pays off
+ * and shrinks while waiters end up parking anyway.
+ */
+namespace parking
+{
+    struct site
+    {
+        static constexpr uint32_t min_spins = 16, max_spins = 16384, yields = 16;
+
+        explicit site(const char* name);
+
+        const char* name;
+
+        std::atomic<uint64_t> waits = 0;        // Waits where the condition didn't hold right away
+        std::atomic<uint64_t> parks = 0;        // Waits that had to park
+        std::atomic<uint64_t> spins = 0;        // Spin iterations of the waits that ended while spinning
+        std::atomic<uint32_t> spin_limit = 1024;
+        std::atomic<uint32_t> parked = 0;       // Threads parked right now
+
+        site* next;
+    };
+
+    inline void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /*
+     * Returns once condition() is true, condition may have side effects (like taking a lock) and is called
+     * until it succeeds once. watched is the atomic that changes when the condition might have become true.
+     */
+    template<typename T, typename Condition>
+    inline void wait_until(std::atomic<T>& watched, Condition condition, site& s)
+    {
+        if (condition()) [[likely]]
+            return;
+
+        s.waits.fetch_add(1, std::memory_order_relaxed);
+
+        auto limit = s.spin_limit.load(std::memory_order_relaxed);
+
+        for (uint32_t i = 1; i <= limit; i++)
+        {
+            cpu_relax();
+
+            if (condition())
+            {
+                s.spins.fetch_add(i, std::memory_order_relaxed);
+                s.spin_limit.store(std::min(site::max_spins, limit + limit / 8), std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        s.spin_limit.store(std::max(site::min_spins, limit - limit / 8), std::memory_order_relaxed);
+
+        // The thread that has to make the condition true may not be running, with more threads than CPUs
+        for (uint32_t i = 0; i < site::yields; i++)
+        {
+            std::this_thread::yield();
+
+            if (condition())
+                return;
+        }
+
+        s.parks.fetch_add(1, std::memory_order_relaxed);
+
+        while (true)
+        {
+            // Announced before the last check, so a notify after the change can't miss this thread
+            s.parked.fetch_add(1);
+            auto value = watched.load();
+
+            if (condition())
+            {
+                s.parked.fetch_sub(1);
+                return;
+            }
+
+            watched.wait(value);
+            s.parked.fetch_sub(1);
+
+            if (condition())
+                return;
+        }
+    }
+
+    // Call after changing watched
+    template<typename T>
+    inline void notify(std::atomic<T>& watched, site& s)
+    {
+        if (s.parked.load() != 0) [[unlikely]]
+            watched.notify_all();
+    }
+
+    // Counters of every site that had to wait since the last reset
+    void report(std::ostream& out);
+    void reset();
+}
+
+#endif //FIREFLY_PARKING_H